@@ -0,0 +1,133 @@
+// Batched compute benchmark.
+//
+// Draws batches of small views of random points orbiting the scene, once view by view (Draw), and once as DrawBatch,
+// which ranks, sorts and projects the views of a chunk in one dispatch each. Reports throughput of both, and the
+// difference of the images from quantized depth keys of the batched sort.
+//
+// Usage: vkgs_batch_bench [point_count] [view_count] [size] [repeat]
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstdlib>
+#include <iostream>
+#include <iomanip>
+#include <random>
+#include <vector>
+
+#include <glm/glm.hpp>
+#include <glm/gtc/matrix_transform.hpp>
+#include <glm/gtc/packing.hpp>
+
+#include "vkgs/gpu/gpu.h"
+#include "vkgs/gpu/device.h"
+#include "vkgs/core/parser.h"
+#include "vkgs/core/renderer.h"
+#include "vkgs/core/rendering_task.h"
+#include "vkgs/core/gaussian_splats.h"
+#include "vkgs/core/screen_splats.h"
+#include "vkgs/core/draw_options.h"
+
+int main(int argc, char** argv) {
+  namespace gpu = vkgs::gpu;
+  namespace core = vkgs::core;
+
+  size_t N = argc > 1 ? std::atoll(argv[1]) : 100000;
+  int view_count = argc > 2 ? std::atoi(argv[2]) : 64;
+  uint32_t size = argc > 3 ? std::atoi(argv[3]) : 128;
+  int repeat = argc > 4 ? std::atoi(argv[4]) : 10;
+
+  size_t image_size = static_cast<size_t>(size) * size * 4;
+
+  gpu::Init({.enable_viewer = false});
+  auto device = gpu::GetDevice();
+
+  auto parser = core::Parser::Create();
+  auto renderer = core::Renderer::Create();
+
+  std::mt19937 rng(0);
+  std::uniform_real_distribution<float> uniform(-1.f, 1.f);
+
+  std::vector<float> means(N * 3);
+  std::vector<float> quats(N * 4, 0.f);
+  std::vector<float> scales(N * 3, 0.01f);
+  std::vector<float> opacities(N, 0.5f);
+  std::vector<uint16_t> colors(N * 3);
+  for (int i = 0; i < N; ++i) {
+    means[i * 3 + 0] = uniform(rng);
+    means[i * 3 + 1] = uniform(rng);
+    means[i * 3 + 2] = uniform(rng);
+    quats[i * 4] = 1.f;
+    // Distinct colors, so that blending order shows in the images.
+    for (int c = 0; c < 3; ++c) colors[i * 3 + c] = glm::packHalf1x16(uniform(rng));
+  }
+
+  auto splats = parser->CreateGaussianSplats(N, means.data(), quats.data(), scales.data(), opacities.data(),
+                                             colors.data(), 0, -1);
+  splats->Wait();
+
+  std::vector<core::DrawOptions> draw_options(view_count);
+  for (int i = 0; i < view_count; ++i) {
+    float angle = 2.f * glm::pi<float>() * i / view_count;
+    glm::vec3 position(4.f * std::cos(angle), 0.f, 4.f * std::sin(angle));
+    draw_options[i] = {
+        .view = glm::lookAtRH(position, glm::vec3(0.f), glm::vec3(0.f, 1.f, 0.f)),
+        .projection = glm::perspectiveRH_ZO(glm::radians(60.f), 1.f, 0.1f, 100.f),
+        .model = glm::mat4(1.f),
+        .width = size,
+        .height = size,
+        .background = {0.f, 0.f, 0.f},
+        .eps2d = 0.3f,
+        .sh_degree = 0,
+        .record_stat = false,
+    };
+  }
+  core::ScreenSplatOptions screen_splat_options = {
+      .confidence_radius = 3.f,
+  };
+
+  std::vector<uint8_t> per_view(view_count * image_size);
+  std::vector<uint8_t> batched(view_count * image_size);
+
+  auto draw = [&](bool batch) {
+    std::vector<core::RenderingTask> tasks;
+    if (batch) {
+      tasks = renderer->DrawBatch(splats, draw_options, screen_splat_options, batched.data());
+    } else {
+      for (int i = 0; i < view_count; ++i) {
+        uint8_t* dst = per_view.data() + i * image_size;
+        tasks.push_back(renderer->Draw(splats, draw_options[i], screen_splat_options, dst));
+      }
+    }
+    for (auto& task : tasks) task->Wait();
+  };
+
+  auto run = [&](bool batch) {
+    // Warm up pipelines and storages.
+    draw(batch);
+
+    auto start = std::chrono::high_resolution_clock::now();
+    for (int r = 0; r < repeat; ++r) draw(batch);
+    auto end = std::chrono::high_resolution_clock::now();
+    return std::chrono::duration<double>(end - start).count();
+  };
+
+  double per_view_seconds = run(false);
+  double batched_seconds = run(true);
+
+  uint32_t diff_max = 0;
+  for (size_t i = 0; i < per_view.size(); ++i) {
+    diff_max = std::max<uint32_t>(diff_max, std::abs(static_cast<int>(per_view[i]) - static_cast<int>(batched[i])));
+  }
+
+  std::cout << "N = " << N << ", views = " << view_count << ", size = " << size << std::endl;
+  std::cout << std::setw(10) << "" << std::setw(12) << "views/s" << std::endl;
+  std::cout << std::setw(10) << "per view" << std::setw(12) << std::fixed << std::setprecision(2)
+            << repeat * view_count / per_view_seconds << std::endl;
+  std::cout << std::setw(10) << "batched" << std::setw(12) << std::fixed << std::setprecision(2)
+            << repeat * view_count / batched_seconds << std::endl;
+  std::cout << "max difference: " << diff_max << " levels" << std::endl;
+
+  return 0;
+}
@@ -26,7 +26,14 @@ if __name__ == "__main__":
     parser.add_argument(
         "--target",
         type=str,
-        choices=["gsplat", "splatstream"],
+        choices=[
+            "gsplat",
+            "splatstream",
+            "splatstream_tile",
+            "splatstream_front_to_back",
+            "splatstream_occlusion",
+            "splatstream_oit",
+        ],
         default="splatstream",
         help="Benchmark target rendering implementation.",
     )
@@ -39,6 +46,12 @@ if __name__ == "__main__":
         default=2,
         help="Chunk size for rendering (gsplat only)",
     )
+    parser.add_argument(
+        "--sh_lod_radius",
+        type=float,
+        default=0.0,
+        help="Screen radius in pixels per evaluated SH degree (splatstream only). 0 evaluates all bands.",
+    )
     args = parser.parse_args()
 
     ply_path = args.ply_path
@@ -47,6 +60,7 @@ if __name__ == "__main__":
     target = args.target
     N = args.first
     chunk_size = args.chunk_size
+    sh_lod_radius = args.sh_lod_radius
 
     # Load data
     print("loading ply data...")
@@ -59,7 +73,33 @@ if __name__ == "__main__":
     if target == "splatstream":
         from draw_splatstream import draw_splatstream
 
-        result = draw_splatstream(ply_data, draw_data)
+        result = draw_splatstream(ply_data, draw_data, sh_lod_radius=sh_lod_radius)
+        if sh_lod_radius > 0:
+            # Images with all SH bands as reference for the quality tradeoff.
+            reference = draw_splatstream(ply_data, draw_data)
+            result["full_sh_colors"] = reference["colors"]
+            result["full_sh_total_time"] = reference["total_time"]
+    elif target == "splatstream_tile":
+        from draw_splatstream import draw_splatstream
+
+        result = draw_splatstream(ply_data, draw_data, rasterizer="tile")
+    elif target == "splatstream_front_to_back":
+        from draw_splatstream import draw_splatstream
+
+        result = draw_splatstream(ply_data, draw_data, front_to_back=True)
+    elif target == "splatstream_occlusion":
+        from draw_splatstream import draw_splatstream
+
+        result = draw_splatstream(
+            ply_data, draw_data, front_to_back=True, occlusion_culling=True
+        )
+    elif target == "splatstream_oit":
+        from draw_splatstream import draw_splatstream
+
+        result = draw_splatstream(ply_data, draw_data, rasterizer="oit")
+        # Sorted images as reference for the approximation error.
+        reference = draw_splatstream(ply_data, draw_data)
+        result["reference_colors"] = reference["colors"]
     elif target == "gsplat":
         from draw_gsplat import draw_gsplat
 
@@ -81,4 +121,25 @@ if __name__ == "__main__":
     print(f"#imgs: {len(result['colors'])}")
     print(f"chunk: {chunk_size}")
     print(f"PSNR: {psnr_mean:.2f} ± {psnr_std:.2f}")
+    if "reference_colors" in result:
+        psnrs = [
+            calculate_psnr(reference, color)
+            for reference, color in zip(result["reference_colors"], result["colors"])
+        ]
+        print(f"PSNR vs sorted: {np.mean(psnrs):.2f} ± {np.std(psnrs):.2f}")
+    if "full_sh_colors" in result:
+        psnrs = [
+            calculate_psnr(reference, color)
+            for reference, color in zip(result["full_sh_colors"], result["colors"])
+        ]
+        print(f"PSNR vs full SH: {np.mean(psnrs):.2f} ± {np.std(psnrs):.2f}")
     print(f"FPS: {len(result['colors']) / result['total_time']:.2f}")
+    if "full_sh_total_time" in result:
+        print(f"FPS full SH: {len(result['colors']) / result['full_sh_total_time']:.2f}")
+    if "fragment_counts" in result and result["fragment_counts"].any():
+        pixels = draw_data["width"] * draw_data["height"]
+        overdraw = np.mean(result["fragment_counts"]) / pixels
+        print(f"overdraw: {overdraw:.2f} fragments/pixel")
+    if "occlusion_culled_counts" in result and result["occlusion_culled_counts"].any():
+        culled = np.mean(result["occlusion_culled_counts"]) / len(ply_data["means"])
+        print(f"occlusion culled: {culled * 100:.2f}%")
@@ -3,7 +3,14 @@ import time
 import splatstream as ss
 
 
-def draw_splatstream(ply_data, draw_data):
+def draw_splatstream(
+    ply_data,
+    draw_data,
+    rasterizer="hardware",
+    front_to_back=False,
+    occlusion_culling=False,
+    sh_lod_radius=0.0,
+):
     print("loading splats...")
     splats = ss.gaussian_splats(
         means=ply_data["means"],
@@ -18,7 +25,7 @@ def draw_splatstream(ply_data, draw_data):
 
     print("drawing...")
     start_time = time.time()
-    images = ss.draw(
+    rendered_images = ss.draw(
         splats=splats,
         viewmats=draw_data["viewmats"],
         Ks=draw_data["Ks"],
@@ -26,7 +33,12 @@ def draw_splatstream(ply_data, draw_data):
         height=draw_data["height"],
         near=0.1,
         far=1e3,
-    ).numpy()
+        rasterizer=rasterizer,
+        front_to_back=front_to_back,
+        occlusion_culling=occlusion_culling,
+        sh_lod_radius=sh_lod_radius,
+    )
+    images = rendered_images.numpy()
     end_time = time.time()
     rendering_time = end_time - start_time
     print("draw end")
@@ -34,4 +46,6 @@ def draw_splatstream(ply_data, draw_data):
     return {
         "colors": images[..., :3],
         "total_time": rendering_time,
+        "fragment_counts": rendered_images.fragment_counts,
+        "occlusion_culled_counts": rendered_images.occlusion_culled_counts,
     }
@@ -0,0 +1,110 @@
+// Projection specialization microbenchmark.
+//
+// Times the screen splat compute pass (rank, sort, projection) for random points all in front of the camera, per SH
+// degree, comparing the generic projection pipeline that branches on degrees at runtime with the pipelines specialized
+// per degree. Rank and sort are the same for both, so the difference is in projection.
+//
+// Usage: vkgs_projection_bench [point_count] [repeat]
+
+#include <cstdint>
+#include <cstdlib>
+#include <iostream>
+#include <iomanip>
+#include <random>
+#include <vector>
+
+#include <glm/glm.hpp>
+#include <glm/gtc/matrix_transform.hpp>
+
+#include "vkgs/gpu/gpu.h"
+#include "vkgs/gpu/device.h"
+#include "vkgs/gpu/timer.h"
+#include "vkgs/gpu/task.h"
+#include "vkgs/gpu/queue_task.h"
+#include "vkgs/core/parser.h"
+#include "vkgs/core/renderer.h"
+#include "vkgs/core/gaussian_splats.h"
+#include "vkgs/core/screen_splats.h"
+#include "vkgs/core/draw_options.h"
+
+int main(int argc, char** argv) {
+  namespace gpu = vkgs::gpu;
+  namespace core = vkgs::core;
+
+  size_t N = argc > 1 ? std::atoll(argv[1]) : 4000000;
+  int repeat = argc > 2 ? std::atoi(argv[2]) : 20;
+
+  gpu::Init({.enable_viewer = false});
+  auto device = gpu::GetDevice();
+
+  VkPhysicalDeviceProperties properties;
+  vkGetPhysicalDeviceProperties(device->physical_device(), &properties);
+  double timestamp_period_ms = properties.limits.timestampPeriod * 1e-6;
+
+  auto parser = core::Parser::Create();
+  auto renderer = core::Renderer::Create();
+  auto screen_splats = core::ScreenSplats::Create();
+  screen_splats->Update(N);
+
+  core::DrawOptions draw_options = {
+      .view = glm::mat4(1.f),
+      .projection = glm::perspectiveRH_ZO(glm::radians(90.f), 1.f, 0.1f, 100.f),
+      .model = glm::mat4(1.f),
+      .width = 1024,
+      .height = 1024,
+      .background = {0.f, 0.f, 0.f},
+      .eps2d = 0.3f,
+      .sh_degree = -1,
+      .record_stat = false,
+  };
+
+  std::mt19937 rng(0);
+  std::uniform_real_distribution<float> uniform(-1.f, 1.f);
+
+  std::vector<float> means(N * 3);
+  std::vector<float> quats(N * 4, 0.f);
+  std::vector<float> scales(N * 3, 0.01f);
+  std::vector<float> opacities(N, 0.5f);
+  for (int i = 0; i < N; ++i) {
+    means[i * 3 + 0] = 2.f * uniform(rng);
+    means[i * 3 + 1] = 2.f * uniform(rng);
+    means[i * 3 + 2] = -4.f + uniform(rng);
+    quats[i * 4] = 1.f;
+  }
+
+  std::cout << "N = " << N << std::endl;
+  std::cout << std::setw(10) << "sh_degree" << std::setw(12) << "generic" << std::setw(14) << "specialized"
+            << "  (ms)" << std::endl;
+
+  for (int sh_degree = 0; sh_degree <= 3; ++sh_degree) {
+    int K = (sh_degree + 1) * (sh_degree + 1);
+    std::vector<uint16_t> colors(N * K * 3, 0);
+
+    auto splats = parser->CreateGaussianSplats(N, means.data(), quats.data(), scales.data(), opacities.data(),
+                                               colors.data(), sh_degree, -1);
+    splats->Wait();
+
+    std::cout << std::setw(10) << sh_degree;
+    for (bool generic_projection : {true, false}) {
+      draw_options.generic_projection = generic_projection;
+
+      double total_ms = 0.;
+      for (int r = 0; r < repeat; ++r) {
+        auto timer = gpu::Timer::Create(2);
+        gpu::ComputeTask task;
+        auto cb = task.command_buffer();
+
+        timer->Record(cb, VK_PIPELINE_STAGE_2_TOP_OF_PIPE_BIT);
+        renderer->ComputeScreenSplats(cb, splats, draw_options, screen_splats, timer);
+        task.Submit()->Wait();
+
+        auto timestamps = timer->GetTimestamps();
+        total_ms += (timestamps[1] - timestamps[0]) * timestamp_period_ms;
+      }
+      std::cout << std::setw(generic_projection ? 12 : 14) << std::fixed << std::setprecision(4) << total_ms / repeat;
+    }
+    std::cout << std::endl;
+  }
+
+  return 0;
+}
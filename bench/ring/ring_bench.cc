@@ -0,0 +1,118 @@
+// Ring depth benchmark.
+//
+// Draws a batch of orbiting views of random points back-to-back, for each ring depth, and reports throughput with the
+// device memory held by the renderer. Deeper rings keep more frames in flight across the compute, graphics and transfer
+// queues, at the cost of one set of storages per ring slot.
+//
+// Usage: vkgs_ring_bench [point_count] [view_count]
+
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstdlib>
+#include <iostream>
+#include <iomanip>
+#include <random>
+#include <vector>
+
+#include <glm/glm.hpp>
+#include <glm/gtc/matrix_transform.hpp>
+
+#include "vkgs/gpu/gpu.h"
+#include "vkgs/gpu/device.h"
+#include "vkgs/core/parser.h"
+#include "vkgs/core/renderer.h"
+#include "vkgs/core/rendering_task.h"
+#include "vkgs/core/gaussian_splats.h"
+#include "vkgs/core/screen_splats.h"
+#include "vkgs/core/draw_options.h"
+
+int main(int argc, char** argv) {
+  namespace gpu = vkgs::gpu;
+  namespace core = vkgs::core;
+
+  size_t N = argc > 1 ? std::atoll(argv[1]) : 1000000;
+  int view_count = argc > 2 ? std::atoi(argv[2]) : 200;
+
+  constexpr uint32_t width = 1024;
+  constexpr uint32_t height = 1024;
+
+  gpu::Init({.enable_viewer = false});
+  auto device = gpu::GetDevice();
+
+  auto parser = core::Parser::Create();
+
+  std::mt19937 rng(0);
+  std::uniform_real_distribution<float> uniform(-1.f, 1.f);
+
+  std::vector<float> means(N * 3);
+  std::vector<float> quats(N * 4, 0.f);
+  std::vector<float> scales(N * 3, 0.01f);
+  std::vector<float> opacities(N, 0.5f);
+  std::vector<uint16_t> colors(N * 3, 0);
+  for (int i = 0; i < N; ++i) {
+    means[i * 3 + 0] = uniform(rng);
+    means[i * 3 + 1] = uniform(rng);
+    means[i * 3 + 2] = uniform(rng);
+    quats[i * 4] = 1.f;
+  }
+
+  auto splats = parser->CreateGaussianSplats(N, means.data(), quats.data(), scales.data(), opacities.data(),
+                                             colors.data(), 0, -1);
+  splats->Wait();
+
+  std::vector<core::DrawOptions> draw_options(view_count);
+  for (int i = 0; i < view_count; ++i) {
+    float angle = 2.f * glm::pi<float>() * i / view_count;
+    glm::vec3 eye(4.f * std::cos(angle), 0.f, 4.f * std::sin(angle));
+    draw_options[i] = {
+        .view = glm::lookAtRH(eye, glm::vec3(0.f), glm::vec3(0.f, 1.f, 0.f)),
+        .projection = glm::perspectiveRH_ZO(glm::radians(60.f), 1.f, 0.1f, 100.f),
+        .model = glm::mat4(1.f),
+        .width = width,
+        .height = height,
+        .background = {0.f, 0.f, 0.f},
+        .eps2d = 0.3f,
+        .sh_degree = 0,
+        .record_stat = false,
+    };
+  }
+  core::ScreenSplatOptions screen_splat_options = {
+      .confidence_radius = 3.f,
+  };
+
+  std::vector<uint8_t> dst(static_cast<size_t>(view_count) * width * height * 4);
+
+  std::cout << "N = " << N << ", views = " << view_count << std::endl;
+  std::cout << std::setw(6) << "ring" << std::setw(12) << "FPS" << std::setw(14) << "memory (MB)" << std::endl;
+
+  for (uint32_t ring_size = core::RendererImpl::kMinRingSize; ring_size <= core::RendererImpl::kMaxRingSize;
+       ++ring_size) {
+    device->WaitIdle();
+    uint64_t base_bytes = device->AllocatedMemorySize();
+
+    auto renderer = core::Renderer::Create(ring_size);
+
+    // Warm up so that every ring slot has allocated its storages.
+    for (uint32_t i = 0; i < ring_size; ++i) {
+      renderer->Draw(splats, draw_options[i % view_count], screen_splat_options, dst.data());
+    }
+    device->WaitIdle();
+    uint64_t renderer_bytes = device->AllocatedMemorySize() - base_bytes;
+
+    auto start = std::chrono::high_resolution_clock::now();
+    std::vector<core::RenderingTask> tasks;
+    for (int i = 0; i < view_count; ++i) {
+      tasks.push_back(renderer->Draw(splats, draw_options[i], screen_splat_options,
+                                     dst.data() + static_cast<size_t>(i) * width * height * 4));
+    }
+    for (auto& task : tasks) task->Wait();
+    auto end = std::chrono::high_resolution_clock::now();
+
+    double seconds = std::chrono::duration<double>(end - start).count();
+    std::cout << std::setw(6) << ring_size << std::setw(12) << std::fixed << std::setprecision(2)
+              << view_count / seconds << std::setw(14) << renderer_bytes / (1024. * 1024.) << std::endl;
+  }
+
+  return 0;
+}
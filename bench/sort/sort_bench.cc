@@ -0,0 +1,167 @@
+// Sorter microbenchmark.
+//
+// Sorts random (key, value) pairs with each sorter backend the device supports, and reports GPU time per size.
+// Keys repeat, and values are input positions, so that results also check the sort is stable: AUTO switches between
+// radix and bitonic by element count, and both must order equal keys alike.
+//
+// Usage: vkgs_sort_bench [repeat]
+
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <iomanip>
+#include <numeric>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "vkgs/gpu/gpu.h"
+#include "vkgs/gpu/device.h"
+#include "vkgs/gpu/buffer.h"
+#include "vkgs/gpu/timer.h"
+#include "vkgs/gpu/task.h"
+#include "vkgs/gpu/queue_task.h"
+#include "vkgs/gpu/cmd/barrier.h"
+#include "vkgs/core/details/sorter.h"
+
+namespace {
+
+using vkgs::core::Sorter;
+using vkgs::core::SorterType;
+
+const char* SorterName(SorterType type) {
+  switch (type) {
+    case SorterType::AUTO:
+      return "auto";
+    case SorterType::RADIX:
+      return "radix";
+    case SorterType::BITONIC:
+      return "bitonic";
+  }
+  return "";
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+  namespace gpu = vkgs::gpu;
+
+  int repeat = argc > 1 ? std::atoi(argv[1]) : 10;
+
+  gpu::Init({.enable_viewer = false});
+  auto device = gpu::GetDevice();
+
+  VkPhysicalDeviceProperties properties;
+  vkGetPhysicalDeviceProperties(device->physical_device(), &properties);
+  double timestamp_period_ms = properties.limits.timestampPeriod * 1e-6;
+
+  std::vector<SorterType> types = {SorterType::RADIX, SorterType::BITONIC, SorterType::AUTO};
+  std::vector<Sorter> sorters;
+  for (auto type : types) sorters.push_back(Sorter::Create(type, device, device->physical_device()));
+
+  std::vector<uint32_t> sizes = {256, 1024, 4096, 16384, 65536, 262144, 1048576, 4194304};
+
+  std::mt19937 rng(0);
+  std::cout << std::setw(10) << "size";
+  for (auto type : types) std::cout << std::setw(12) << SorterName(type);
+  std::cout << "  (ms)" << std::endl;
+
+  for (auto N : sizes) {
+    // About a third of the keys are duplicates.
+    std::vector<uint32_t> keys(N);
+    for (auto& key : keys) key = rng() % N;
+    std::vector<uint32_t> values(N);
+    std::iota(values.begin(), values.end(), 0);
+
+    std::cout << std::setw(10) << N;
+    for (int t = 0; t < types.size(); ++t) {
+      auto sorter = sorters[t];
+      if (!sorter->Supports(N)) {
+        std::cout << std::setw(12) << "-";
+        continue;
+      }
+
+      auto requirements = sorter->GetStorageRequirements(N);
+      auto size_stage = gpu::Buffer::Create(VK_BUFFER_USAGE_TRANSFER_SRC_BIT, sizeof(uint32_t), true);
+      auto key_stage = gpu::Buffer::Create(VK_BUFFER_USAGE_TRANSFER_SRC_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT,
+                                           N * sizeof(uint32_t), true);
+      auto size = gpu::Buffer::Create(
+          VK_BUFFER_USAGE_TRANSFER_DST_BIT | VK_BUFFER_USAGE_STORAGE_BUFFER_BIT | VK_BUFFER_USAGE_INDIRECT_BUFFER_BIT,
+          sizeof(uint32_t));
+      auto key = gpu::Buffer::Create(
+          VK_BUFFER_USAGE_TRANSFER_SRC_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT | VK_BUFFER_USAGE_STORAGE_BUFFER_BIT,
+          N * sizeof(uint32_t));
+      auto value_stage = gpu::Buffer::Create(VK_BUFFER_USAGE_TRANSFER_SRC_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT,
+                                             N * sizeof(uint32_t), true);
+      auto value = gpu::Buffer::Create(
+          VK_BUFFER_USAGE_TRANSFER_SRC_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT | VK_BUFFER_USAGE_STORAGE_BUFFER_BIT,
+          N * sizeof(uint32_t));
+      auto storage = gpu::Buffer::Create(requirements.usage, requirements.size);
+
+      *size_stage->data<uint32_t>() = N;
+
+      double total_ms = 0.;
+      bool sorted = true;
+      for (int r = 0; r < repeat; ++r) {
+        std::memcpy(key_stage->data(), keys.data(), N * sizeof(uint32_t));
+        std::memcpy(value_stage->data(), values.data(), N * sizeof(uint32_t));
+
+        auto timer = gpu::Timer::Create(2);
+        gpu::ComputeTask task;
+        auto cb = task.command_buffer();
+
+        VkBufferCopy region = {0, 0, sizeof(uint32_t)};
+        vkCmdCopyBuffer(cb, size_stage, size, 1, &region);
+        region = {0, 0, N * sizeof(uint32_t)};
+        vkCmdCopyBuffer(cb, key_stage, key, 1, &region);
+        vkCmdCopyBuffer(cb, value_stage, value, 1, &region);
+
+        gpu::cmd::Barrier()
+            .Memory(VK_PIPELINE_STAGE_2_TRANSFER_BIT, VK_ACCESS_2_TRANSFER_WRITE_BIT,
+                    VK_PIPELINE_STAGE_2_COMPUTE_SHADER_BIT | VK_PIPELINE_STAGE_2_TRANSFER_BIT |
+                        VK_PIPELINE_STAGE_2_DRAW_INDIRECT_BIT,
+                    VK_ACCESS_2_SHADER_READ_BIT | VK_ACCESS_2_SHADER_WRITE_BIT | VK_ACCESS_2_TRANSFER_READ_BIT |
+                        VK_ACCESS_2_INDIRECT_COMMAND_READ_BIT)
+            .Commit(cb);
+
+        timer->Record(cb, VK_PIPELINE_STAGE_2_ALL_COMMANDS_BIT);
+        sorter->SortKeyValueIndirect(cb, N, size, key, value, storage);
+        timer->Record(cb, VK_PIPELINE_STAGE_2_ALL_COMMANDS_BIT);
+
+        gpu::cmd::Barrier()
+            .Memory(VK_PIPELINE_STAGE_2_COMPUTE_SHADER_BIT, VK_ACCESS_2_SHADER_WRITE_BIT,
+                    VK_PIPELINE_STAGE_2_TRANSFER_BIT, VK_ACCESS_2_TRANSFER_READ_BIT)
+            .Commit(cb);
+        vkCmdCopyBuffer(cb, key, key_stage, 1, &region);
+        vkCmdCopyBuffer(cb, value, value_stage, 1, &region);
+
+        task.Submit()->Wait();
+
+        auto timestamps = timer->GetTimestamps();
+        total_ms += (timestamps[1] - timestamps[0]) * timestamp_period_ms;
+
+        // Ascending keys carrying their values, with equal keys in input order.
+        const auto* result = key_stage->data<uint32_t>();
+        const auto* result_values = value_stage->data<uint32_t>();
+        for (int i = 0; i < N; ++i) {
+          bool ordered = i == 0 || result[i - 1] < result[i] ||
+                         (result[i - 1] == result[i] && result_values[i - 1] < result_values[i]);
+          if (!ordered || result_values[i] >= N || keys[result_values[i]] != result[i]) {
+            sorted = false;
+            break;
+          }
+        }
+      }
+
+      if (sorted) {
+        std::cout << std::setw(12) << std::fixed << std::setprecision(4) << total_ms / repeat;
+      } else {
+        std::cout << std::setw(12) << "FAIL";
+      }
+    }
+    std::cout << std::endl;
+  }
+
+  return 0;
+}
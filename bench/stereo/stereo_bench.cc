@@ -0,0 +1,145 @@
+// Stereo rendering benchmark.
+//
+// Draws stereo pairs of random points orbiting the scene, once with independent visibility and sort per eye
+// (DrawBatch), and once sharing them per pair (DrawStereo). Reports throughput of both, and the ordering error of the
+// shared sort as the difference of the images from the independent ones.
+//
+// Usage: vkgs_stereo_bench [point_count] [pair_count] [baseline]
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstdlib>
+#include <iostream>
+#include <iomanip>
+#include <random>
+#include <vector>
+
+#include <glm/glm.hpp>
+#include <glm/gtc/matrix_transform.hpp>
+#include <glm/gtc/packing.hpp>
+
+#include "vkgs/gpu/gpu.h"
+#include "vkgs/gpu/device.h"
+#include "vkgs/core/parser.h"
+#include "vkgs/core/renderer.h"
+#include "vkgs/core/rendering_task.h"
+#include "vkgs/core/gaussian_splats.h"
+#include "vkgs/core/screen_splats.h"
+#include "vkgs/core/draw_options.h"
+
+int main(int argc, char** argv) {
+  namespace gpu = vkgs::gpu;
+  namespace core = vkgs::core;
+
+  size_t N = argc > 1 ? std::atoll(argv[1]) : 1000000;
+  int pair_count = argc > 2 ? std::atoi(argv[2]) : 50;
+  float baseline = argc > 3 ? std::atof(argv[3]) : 0.064f;
+
+  constexpr uint32_t width = 1024;
+  constexpr uint32_t height = 1024;
+  constexpr size_t image_size = static_cast<size_t>(width) * height * 4;
+
+  gpu::Init({.enable_viewer = false});
+  auto device = gpu::GetDevice();
+
+  auto parser = core::Parser::Create();
+  auto renderer = core::Renderer::Create();
+
+  std::mt19937 rng(0);
+  std::uniform_real_distribution<float> uniform(-1.f, 1.f);
+
+  std::vector<float> means(N * 3);
+  std::vector<float> quats(N * 4, 0.f);
+  std::vector<float> scales(N * 3, 0.01f);
+  std::vector<float> opacities(N, 0.5f);
+  std::vector<uint16_t> colors(N * 3);
+  for (int i = 0; i < N; ++i) {
+    means[i * 3 + 0] = uniform(rng);
+    means[i * 3 + 1] = uniform(rng);
+    means[i * 3 + 2] = uniform(rng);
+    quats[i * 4] = 1.f;
+    // Distinct colors, so that blending order shows in the images.
+    for (int c = 0; c < 3; ++c) colors[i * 3 + c] = glm::packHalf1x16(uniform(rng));
+  }
+
+  auto splats = parser->CreateGaussianSplats(N, means.data(), quats.data(), scales.data(), opacities.data(),
+                                             colors.data(), 0, -1);
+  splats->Wait();
+
+  // (left, right) eyes, offset along the right axis of the camera looking at the center.
+  std::vector<core::DrawOptions> draw_options(2 * pair_count);
+  for (int i = 0; i < pair_count; ++i) {
+    float angle = 2.f * glm::pi<float>() * i / pair_count;
+    glm::vec3 center(4.f * std::cos(angle), 0.f, 4.f * std::sin(angle));
+    glm::vec3 right = glm::normalize(glm::cross(-center, glm::vec3(0.f, 1.f, 0.f)));
+    for (int eye = 0; eye < 2; ++eye) {
+      glm::vec3 position = center + (eye == 0 ? -0.5f : 0.5f) * baseline * right;
+      draw_options[2 * i + eye] = {
+          .view = glm::lookAtRH(position, position - center, glm::vec3(0.f, 1.f, 0.f)),
+          .projection = glm::perspectiveRH_ZO(glm::radians(90.f), 1.f, 0.1f, 100.f),
+          .model = glm::mat4(1.f),
+          .width = width,
+          .height = height,
+          .background = {0.f, 0.f, 0.f},
+          .eps2d = 0.3f,
+          .sh_degree = 0,
+          .record_stat = false,
+          .deterministic = true,
+      };
+    }
+  }
+  core::ScreenSplatOptions screen_splat_options = {
+      .confidence_radius = 3.f,
+  };
+
+  std::vector<uint8_t> independent(draw_options.size() * image_size);
+  std::vector<uint8_t> stereo(draw_options.size() * image_size);
+
+  auto draw = [&](bool shared, const std::vector<core::DrawOptions>& options, uint8_t* dst) {
+    return shared ? renderer->DrawStereo(splats, options, screen_splat_options, dst)
+                  : renderer->DrawBatch(splats, options, screen_splat_options, dst);
+  };
+
+  auto run = [&](bool shared, uint8_t* dst) {
+    // Warm up pipelines and storages.
+    for (auto& task : draw(shared, {draw_options[0], draw_options[1]}, dst)) task->Wait();
+
+    auto start = std::chrono::high_resolution_clock::now();
+    for (auto& task : draw(shared, draw_options, dst)) task->Wait();
+    auto end = std::chrono::high_resolution_clock::now();
+    return std::chrono::duration<double>(end - start).count();
+  };
+
+  double independent_seconds = run(false, independent.data());
+  double stereo_seconds = run(true, stereo.data());
+
+  // Ordering error, over color channels.
+  uint64_t diff_sum = 0;
+  uint32_t diff_max = 0;
+  uint64_t diff_pixel_count = 0;
+  for (size_t p = 0; p < independent.size(); p += 4) {
+    uint32_t pixel_diff = 0;
+    for (int c = 0; c < 3; ++c) {
+      uint32_t diff = std::abs(static_cast<int>(independent[p + c]) - static_cast<int>(stereo[p + c]));
+      diff_sum += diff;
+      pixel_diff = std::max(pixel_diff, diff);
+    }
+    diff_max = std::max(diff_max, pixel_diff);
+    if (pixel_diff > 1) diff_pixel_count++;
+  }
+  size_t pixel_count = independent.size() / 4;
+
+  std::cout << "N = " << N << ", pairs = " << pair_count << ", baseline = " << baseline << std::endl;
+  std::cout << std::setw(14) << "" << std::setw(12) << "pairs/s" << std::endl;
+  std::cout << std::setw(14) << "independent" << std::setw(12) << std::fixed << std::setprecision(2)
+            << pair_count / independent_seconds << std::endl;
+  std::cout << std::setw(14) << "stereo" << std::setw(12) << std::fixed << std::setprecision(2)
+            << pair_count / stereo_seconds << std::endl;
+  std::cout << "ordering error: mean " << std::setprecision(4) << static_cast<double>(diff_sum) / (pixel_count * 3)
+            << " levels, max " << diff_max << " levels, " << 100. * diff_pixel_count / pixel_count
+            << "% pixels off by more than 1 level" << std::endl;
+
+  return 0;
+}
@@ -1,5 +1,12 @@
 #include <pybind11/pybind11.h>
 #include <pybind11/numpy.h>
+#include <pybind11/stl.h>
+
+#include <cstring>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <vector>
 
 #include "vkgs/engine.h"
 #include "vkgs/gaussian_splats.h"
@@ -8,14 +15,178 @@
 
 namespace py = pybind11;
 
+namespace {
+
+template <typename T>
+using Array = py::array_t<T, py::array::c_style | py::array::forcecast>;
+
+/**
+ * @brief Draw options of a batch of views, converted once from numpy cameras and reused across draws.
+ */
+struct DrawOptionsBatch {
+  uint32_t width = 0;
+  uint32_t height = 0;
+  std::vector<vkgs::DrawOptions> draw_options;
+};
+
+/**
+ * @brief Sets view and projection from a row-major np-style (Y-down) view matrix and pixel intrinsics.
+ */
+void SetCamera(vkgs::DrawOptions& options, const float* viewmat, const float* K, uint32_t width, uint32_t height,
+               float z_near, float z_far) {
+  // Y-down to vulkan-style Y-up view, and row-major to column-major.
+  for (int r = 0; r < 4; ++r) {
+    float sign = r == 1 || r == 2 ? -1.f : 1.f;
+    for (int c = 0; c < 4; ++c) options.view[c * 4 + r] = sign * viewmat[r * 4 + c];
+  }
+
+  // Image space (0, 0), (W, H) to (-1, 1), (1, -1).
+  float k[3][3];
+  for (int c = 0; c < 3; ++c) {
+    k[0][c] = 2.f / width * K[c] - K[6 + c];
+    k[1][c] = -2.f / height * K[3 + c] + K[6 + c];
+    k[2][c] = K[6 + c];
+  }
+
+  // Intrinsic to projection with depth in [0, 1] from near to far.
+  float projection[4][4] = {
+      {k[0][0], k[0][1], 0.f, k[0][2]},
+      {k[1][0], k[1][1], 0.f, k[1][2]},
+      {0.f, 0.f, z_far / (z_near - z_far), z_near * z_far / (z_near - z_far)},
+      {k[2][0], k[2][1], -1.f, 0.f},
+  };
+  for (int r = 0; r < 4; ++r) {
+    for (int c = 0; c < 4; ++c) {
+      options.projection[c * 4 + r] = projection[r][c];
+      options.model[c * 4 + r] = r == c;  // Identity matrix
+    }
+  }
+}
+
+/**
+ * @brief Pixels of one output image of draw options, of the region of interest if any.
+ */
+size_t PixelCount(const vkgs::DrawOptions& options) {
+  if (options.roi[2] != 0 && options.roi[3] != 0) return static_cast<size_t>(options.roi[2]) * options.roi[3];
+  return static_cast<size_t>(options.width) * options.height;
+}
+
+/**
+ * @brief Bytes of one output image of draw options.
+ */
+size_t OutputSize(const vkgs::DrawOptions& options) {
+  size_t pixel_count = PixelCount(options);
+  switch (options.output_format) {
+    case vkgs::OutputFormat::RGB8:
+      return pixel_count * 3;
+    case vkgs::OutputFormat::RGBA16F:
+      return pixel_count * 4 * 2;
+    case vkgs::OutputFormat::RGB32F:
+      return pixel_count * 3 * 4;
+    default:
+      return pixel_count * 4;
+  }
+}
+
+/**
+ * @brief Bytes of one depth output image of draw options, (H, W, 4) float32.
+ */
+size_t DepthOutputSize(const vkgs::DrawOptions& options) {
+  return PixelCount(options) * 4 * sizeof(float);
+}
+
+/**
+ * @brief Checks that dst is a writeable C-contiguous array of size bytes with elements of kind and itemsize, as the
+ * renderer writes it through a raw pointer with the GIL released.
+ */
+void CheckOutput(const py::array& dst, size_t size, char kind, size_t itemsize, const char* name) {
+  if (!(dst.flags() & py::array::c_style)) throw std::invalid_argument(std::string(name) + " must be C-contiguous");
+  if (!dst.writeable()) throw std::invalid_argument(std::string(name) + " must be writeable");
+  if (dst.dtype().kind() != kind || static_cast<size_t>(dst.itemsize()) != itemsize)
+    throw std::invalid_argument(std::string(name) + " has a wrong dtype for the output format");
+  if (static_cast<size_t>(dst.nbytes()) != size)
+    throw std::invalid_argument(std::string(name) + " has " + std::to_string(dst.nbytes()) + " bytes, expected " +
+                                std::to_string(size));
+}
+
+/**
+ * @brief Checks color and optional depth outputs of count images of draw options.
+ */
+void CheckOutputs(const py::array& dst, const std::optional<py::array>& depth_dst, const vkgs::DrawOptions& options,
+                  size_t count) {
+  size_t itemsize = 1;
+  if (options.output_format == vkgs::OutputFormat::RGBA16F) itemsize = 2;
+  if (options.output_format == vkgs::OutputFormat::RGB32F) itemsize = 4;
+  CheckOutput(dst, OutputSize(options) * count, itemsize == 1 ? 'u' : 'f', itemsize, "dst");
+  if (depth_dst) CheckOutput(*depth_dst, DepthOutputSize(options) * count, 'f', sizeof(float), "depth_dst");
+}
+
+void SetCameras(DrawOptionsBatch& batch, Array<float> viewmats, Array<float> Ks, Array<float> z_near,
+                Array<float> z_far) {
+  size_t B = batch.draw_options.size();
+  if (viewmats.size() != B * 16 || Ks.size() != B * 9 || z_near.size() != B || z_far.size() != B)
+    throw std::invalid_argument("cameras do not match the batch size");
+
+  const auto* viewmats_ptr = viewmats.data();
+  const auto* Ks_ptr = Ks.data();
+  const auto* z_near_ptr = z_near.data();
+  const auto* z_far_ptr = z_far.data();
+  for (size_t i = 0; i < B; ++i) {
+    SetCamera(batch.draw_options[i], viewmats_ptr + i * 16, Ks_ptr + i * 9, batch.width, batch.height,
+              z_near_ptr[i], z_far_ptr[i]);
+  }
+}
+
+}  // namespace
+
 PYBIND11_MODULE(_core, m) {
+  py::class_<DrawOptionsBatch>(m, "DrawOptionsBatch")
+      .def(py::init([](Array<float> viewmats, Array<float> Ks, Array<float> z_near, Array<float> z_far,
+                       uint32_t width, uint32_t height, Array<float> backgrounds, Array<float> eps2d,
+                       Array<int> sh_degree, float sh_lod_radius, float color_cache_angle, int rasterizer,
+                       bool front_to_back, bool occlusion_culling, int output_format, bool output_planar,
+                       bool output_srgb, bool output_depth, Array<uint32_t> rois) {
+             size_t B = viewmats.size() / 16;
+             if (backgrounds.size() != B * 3 || eps2d.size() != B || sh_degree.size() != B || rois.size() != B * 4)
+               throw std::invalid_argument("draw options do not match the batch size");
+
+             DrawOptionsBatch batch;
+             batch.width = width;
+             batch.height = height;
+             batch.draw_options.resize(B);
+             for (size_t i = 0; i < B; ++i) {
+               auto& options = batch.draw_options[i];
+               options.width = width;
+               options.height = height;
+               std::memcpy(options.background, backgrounds.data() + i * 3, 3 * sizeof(float));
+               options.eps2d = eps2d.data()[i];
+               options.confidence_radius = 3.5f;
+               options.sh_degree = sh_degree.data()[i];
+               options.sh_lod_radius = sh_lod_radius;
+               options.color_cache_angle = color_cache_angle;
+               options.rasterizer = static_cast<vkgs::Rasterizer>(rasterizer);
+               options.front_to_back = front_to_back;
+               options.occlusion_culling = occlusion_culling;
+               options.output_format = static_cast<vkgs::OutputFormat>(output_format);
+               options.output_planar = output_planar;
+               options.output_srgb = output_srgb;
+               options.output_depth = output_depth;
+               std::memcpy(options.roi, rois.data() + i * 4, 4 * sizeof(uint32_t));
+             }
+             SetCameras(batch, viewmats, Ks, z_near, z_far);
+             return batch;
+           }))
+      .def("__len__", [](const DrawOptionsBatch& batch) { return batch.draw_options.size(); })
+      .def("set_cameras", &SetCameras);
+
   py::class_<vkgs::Engine>(m, "Engine")
-      .def(py::init<>())
+      .def(py::init<uint32_t>(), py::arg("ring_size") = 2)
       .def_property_readonly("device_name", &vkgs::Engine::device_name)
+      .def_property_readonly("ring_size", &vkgs::Engine::ring_size)
       .def_property_readonly("graphics_queue_index", &vkgs::Engine::graphics_queue_index)
       .def_property_readonly("compute_queue_index", &vkgs::Engine::compute_queue_index)
       .def_property_readonly("transfer_queue_index", &vkgs::Engine::transfer_queue_index)
-      .def("load_from_ply", &vkgs::Engine::LoadFromPly)
+      .def("load_from_ply", &vkgs::Engine::LoadFromPly, py::call_guard<py::gil_scoped_release>())
       .def("create_gaussian_splats",
            [](vkgs::Engine& engine, py::array_t<float> means, py::array_t<float> quats, py::array_t<float> scales,
               py::array_t<float> opacities, intptr_t colors_ptr, int sh_degree, int opacity_degree) {
@@ -25,42 +196,71 @@ PYBIND11_MODULE(_core, m) {
              const auto* scales_ptr = static_cast<const float*>(scales.request().ptr);
              const auto* opacities_ptr = static_cast<const float*>(opacities.request().ptr);
              const auto* colors_u16_ptr = reinterpret_cast<const uint16_t*>(colors_ptr);
+
+             py::gil_scoped_release release;
              return engine.CreateGaussianSplats(N, means_ptr, quats_ptr, scales_ptr, opacities_ptr, colors_u16_ptr,
                                                 sh_degree, opacity_degree);
            })
       .def("draw",
-           [](vkgs::Engine& engine, vkgs::GaussianSplats splats, py::array_t<float> view, py::array_t<float> projection,
-              uint32_t width, uint32_t height, py::array_t<float> background, float eps2d, int sh_degree,
-              py::array_t<uint8_t> dst) {
-             const auto* background_ptr = static_cast<const float*>(background.request().ptr);
-             const auto* view_ptr = static_cast<const float*>(view.request().ptr);
-             const auto* projection_ptr = static_cast<const float*>(projection.request().ptr);
-             auto* dst_ptr = static_cast<uint8_t*>(dst.request().ptr);
-
-             vkgs::DrawOptions draw_options = {};
-             // row-major data to column-major
-             for (int r = 0; r < 4; ++r) {
-               for (int c = 0; c < 4; ++c) {
-                 draw_options.view[c * 4 + r] = view_ptr[r * 4 + c];
-                 draw_options.projection[c * 4 + r] = projection_ptr[r * 4 + c];
-                 draw_options.model[c * 4 + r] = r == c;  // Identity matrix
-               }
+           [](vkgs::Engine& engine, vkgs::GaussianSplats splats, const DrawOptionsBatch& batch, size_t index,
+              py::array dst, std::optional<py::array> depth_dst) {
+             vkgs::DrawOptions draw_options = batch.draw_options.at(index);
+             CheckOutputs(dst, depth_dst, draw_options, 1);
+             auto* dst_ptr = static_cast<uint8_t*>(dst.mutable_data());
+             auto* depth_dst_ptr = depth_dst ? static_cast<float*>(depth_dst->mutable_data()) : nullptr;
+
+             py::gil_scoped_release release;
+             return engine.Draw(splats, draw_options, dst_ptr, depth_dst_ptr);
+           })
+      .def("draw_tiled",
+           [](vkgs::Engine& engine, vkgs::GaussianSplats splats, const DrawOptionsBatch& batch, size_t index,
+              uint32_t tile_size, py::array dst, std::optional<py::array> depth_dst) {
+             vkgs::DrawOptions draw_options = batch.draw_options.at(index);
+             CheckOutputs(dst, depth_dst, draw_options, 1);
+             auto* dst_ptr = static_cast<uint8_t*>(dst.mutable_data());
+             auto* depth_dst_ptr = depth_dst ? static_cast<float*>(depth_dst->mutable_data()) : nullptr;
+
+             py::gil_scoped_release release;
+             return engine.DrawTiled(splats, draw_options, dst_ptr, depth_dst_ptr, tile_size);
+           })
+      .def("draw_batch",
+           [](vkgs::Engine& engine, vkgs::GaussianSplats splats, const DrawOptionsBatch& batch, bool stereo,
+              py::array dst, std::optional<py::array> depth_dst) {
+             if (batch.draw_options.empty()) throw std::invalid_argument("batch is empty");
+             CheckOutputs(dst, depth_dst, batch.draw_options[0], batch.draw_options.size());
+             auto* dst_ptr = static_cast<uint8_t*>(dst.mutable_data());
+             auto* depth_dst_ptr = depth_dst ? static_cast<float*>(depth_dst->mutable_data()) : nullptr;
+             // Copied, so that cameras of the batch may be updated while the draw is recorded.
+             std::vector<vkgs::DrawOptions> draw_options = batch.draw_options;
+
+             py::gil_scoped_release release;
+             if (stereo) return engine.DrawStereo(splats, draw_options, dst_ptr, depth_dst_ptr);
+             return engine.DrawBatch(splats, draw_options, dst_ptr, depth_dst_ptr);
+           })
+      .def("draw_cubemap",
+           [](vkgs::Engine& engine, vkgs::GaussianSplats splats, const DrawOptionsBatch& batch, size_t index,
+              uint32_t equirect_width, py::array dst) {
+             vkgs::DrawOptions draw_options = batch.draw_options.at(index);
+             // Six faces, or one panorama of (equirect_width / 2, equirect_width).
+             vkgs::DrawOptions output_options = draw_options;
+             if (equirect_width > 0) {
+               output_options.width = equirect_width;
+               output_options.height = equirect_width / 2;
              }
-             draw_options.width = width;
-             draw_options.height = height;
-             std::memcpy(draw_options.background, background_ptr, 3 * sizeof(float));
-             draw_options.eps2d = eps2d;
-             draw_options.confidence_radius = 3.5f;
-             draw_options.sh_degree = sh_degree;
-             return engine.Draw(splats, draw_options, dst_ptr);
+             CheckOutputs(dst, std::nullopt, output_options, equirect_width > 0 ? 1 : 6);
+             auto* dst_ptr = static_cast<uint8_t*>(dst.mutable_data());
+
+             py::gil_scoped_release release;
+             return engine.DrawCubemap(splats, draw_options, dst_ptr, equirect_width);
            })
-      .def("show", &vkgs::Engine::Show)
+      .def("show", &vkgs::Engine::Show, py::call_guard<py::gil_scoped_release>())
       .def("show_with_cameras", [](vkgs::Engine& engine, vkgs::GaussianSplats splats, py::array_t<float> extrinsics,
                                    py::array_t<float> intrinsics, uint32_t width, uint32_t height) {
         size_t N = extrinsics.shape(0);
         const auto* extrinsics_ptr = static_cast<const float*>(extrinsics.request().ptr);
         const auto* intrinsics_ptr = static_cast<const float*>(intrinsics.request().ptr);
 
+        py::gil_scoped_release release;
         engine.ClearCameras();
 
         for (auto i = 0; i < N; ++i) {
@@ -80,14 +280,18 @@ PYBIND11_MODULE(_core, m) {
 
   py::class_<vkgs::GaussianSplats>(m, "GaussianSplats")
       .def_property_readonly("size", &vkgs::GaussianSplats::size)
-      .def("wait", &vkgs::GaussianSplats::Wait);
+      .def("wait", &vkgs::GaussianSplats::Wait, py::call_guard<py::gil_scoped_release>());
 
   py::class_<vkgs::RenderingTask>(m, "RenderingTask")
-      .def("wait", &vkgs::RenderingTask::Wait)
+      .def("wait", &vkgs::RenderingTask::Wait, py::call_guard<py::gil_scoped_release>())
+      .def("ready", &vkgs::RenderingTask::IsReady)
       .def("draw_result", &vkgs::RenderingTask::draw_result);
 
   py::class_<vkgs::DrawResult>(m, "DrawResult")
       .def_readonly("compute_timestamp", &vkgs::DrawResult::compute_timestamp)
       .def_readonly("graphics_timestamp", &vkgs::DrawResult::graphics_timestamp)
-      .def_readonly("transfer_timestamp", &vkgs::DrawResult::transfer_timestamp);
+      .def_readonly("transfer_timestamp", &vkgs::DrawResult::transfer_timestamp)
+      .def_readonly("fragment_count", &vkgs::DrawResult::fragment_count)
+      .def_readonly("occlusion_culled_count", &vkgs::DrawResult::occlusion_culled_count)
+      .def_readonly("dropped_tile_pair_count", &vkgs::DrawResult::dropped_tile_pair_count);
 }
@@ -1,8 +1,23 @@
-from .renderer import gaussian_splats, load_from_ply, draw, show
+from .renderer import (
+    gaussian_splats,
+    load_from_ply,
+    draw,
+    draw_async,
+    draw_cubemap,
+    show,
+)
+from .draw_context import DrawContext
+from .image_sink import ImageSink
+from .stream import render_stream
 
 __all__ = [
+    "DrawContext",
+    "ImageSink",
     "gaussian_splats",
     "load_from_ply",
     "draw",
+    "draw_async",
+    "draw_cubemap",
+    "render_stream",
     "show",
 ]
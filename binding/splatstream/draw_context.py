@@ -0,0 +1,77 @@
+import numpy as np
+
+from . import _core
+from .rendered_image import RenderedImage
+from .renderer import _plan, _submit
+
+
+class DrawContext:
+    """
+    Repeated draws of one batch of cameras and draw options, e.g. tight loops over trajectories. Cameras are converted
+    once, on construction and by set_cameras, and output images rotate through buffer_count preallocated buffers, so
+    draws do not allocate.
+
+    An image returned by draw is overwritten buffer_count draws later. Copy it, or draw with out=, to keep it.
+    """
+
+    def __init__(
+        self,
+        viewmats: np.ndarray,
+        Ks: np.ndarray,
+        width: int,
+        height: int,
+        buffer_count: int = 2,
+        **kwargs,
+    ):
+        """
+        viewmats, Ks, width, height and kwargs: as in draw, except out.
+        buffer_count: output buffers reused in turn. A draw first waits for the previous draw into its buffer.
+        """
+        assert buffer_count >= 1
+        self._plan = _plan(viewmats, Ks, width, height, **kwargs)
+        self._buffers = [self._plan.allocate() for _ in range(buffer_count)]
+        self._rendered_images: list[RenderedImage | None] = [None] * buffer_count
+        self._index = 0
+
+    @property
+    def batch_dims(self) -> tuple[int, ...]:
+        return self._plan.batch_dims
+
+    def set_cameras(self, viewmats: np.ndarray, Ks: np.ndarray):
+        """
+        viewmats: (..., 4, 4), broadcasting to the batch dims.
+        Ks: (..., 3, 3), broadcasting to the batch dims.
+        Draws already submitted keep their cameras.
+        """
+        self._plan.set_cameras(viewmats, Ks)
+
+    def draw(
+        self,
+        splats: _core.GaussianSplats,
+        viewmats: np.ndarray | None = None,
+        Ks: np.ndarray | None = None,
+        out: np.ndarray | None = None,
+    ) -> RenderedImage:
+        """
+        viewmats, Ks: if given, set_cameras before drawing.
+        out: as in draw. Images are written there instead of the next buffer of the context.
+        """
+        if viewmats is not None or Ks is not None:
+            assert viewmats is not None and Ks is not None, "set both viewmats and Ks"
+            self.set_cameras(viewmats, Ks)
+
+        if out is not None:
+            images, depths = self._plan.allocate(out)
+            return _submit(splats, self._plan, images, depths)
+
+        index = self._index
+        self._index = (index + 1) % len(self._buffers)
+
+        previous = self._rendered_images[index]
+        if previous is not None:
+            previous._wait()
+
+        images, depths = self._buffers[index]
+        rendered_image = _submit(splats, self._plan, images, depths)
+        self._rendered_images[index] = rendered_image
+        return rendered_image
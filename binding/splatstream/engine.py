@@ -2,8 +2,15 @@ from . import _core
 
 
 class Engine:
-    def __init__(self):
-        self.engine = _core.Engine()
+    def __init__(self, ring_size: int = 2):
+        """
+        ring_size: frames in flight, in [2, 8]. Deeper rings overlap more draws at the cost of memory per frame.
+        """
+        self.engine = _core.Engine(ring_size)
+
+    @property
+    def ring_size(self) -> int:
+        return self.engine.ring_size
 
     def create_gaussian_splats(self, *args, **kwargs):
         return self.engine.create_gaussian_splats(*args, **kwargs)
@@ -14,6 +21,15 @@ class Engine:
     def draw(self, *args, **kwargs):
         return self.engine.draw(*args, **kwargs)
 
+    def draw_tiled(self, *args, **kwargs):
+        return self.engine.draw_tiled(*args, **kwargs)
+
+    def draw_batch(self, *args, **kwargs):
+        return self.engine.draw_batch(*args, **kwargs)
+
+    def draw_cubemap(self, *args, **kwargs):
+        return self.engine.draw_cubemap(*args, **kwargs)
+
     def show(self, *args, **kwargs):
         return self.engine.show(*args, **kwargs)
 
@@ -0,0 +1,209 @@
+import os
+import struct
+import threading
+from concurrent.futures import Future, ThreadPoolExecutor
+from typing import Callable
+
+import numpy as np
+
+from .rendered_image import RenderedImage
+
+
+def _write_exr(path: str, image: np.ndarray):
+    """Uncompressed scanline OpenEXR of (H, W, C) float16 or float32 images, C in [1, 4]."""
+    height, width, channels = image.shape
+    pixel_type = {np.dtype(np.float16): 1, np.dtype(np.float32): 2}[image.dtype]
+
+    # Channels are stored in alphabetical order of their names.
+    names = ["Y"] if channels == 1 else ["R", "G", "B", "A"][:channels]
+    order = sorted(range(channels), key=lambda c: names[c])
+
+    def attribute(name: str, type_name: str, value: bytes) -> bytes:
+        size = struct.pack("<i", len(value))
+        return name.encode() + b"\0" + type_name.encode() + b"\0" + size + value
+
+    channel_list = b"".join(
+        names[c].encode() + b"\0" + struct.pack("<iB3xii", pixel_type, 0, 1, 1)
+        for c in order
+    )
+    window = struct.pack("<iiii", 0, 0, width - 1, height - 1)
+    header = b"".join(
+        [
+            struct.pack("<ii", 20000630, 2),
+            attribute("channels", "chlist", channel_list + b"\0"),
+            attribute("compression", "compression", b"\0"),
+            attribute("dataWindow", "box2i", window),
+            attribute("displayWindow", "box2i", window),
+            attribute("lineOrder", "lineOrder", b"\0"),
+            attribute("pixelAspectRatio", "float", struct.pack("<f", 1.0)),
+            attribute("screenWindowCenter", "v2f", struct.pack("<ff", 0.0, 0.0)),
+            attribute("screenWindowWidth", "float", struct.pack("<f", 1.0)),
+            b"\0",
+        ]
+    )
+
+    # One block per scanline: y, byte count, then each channel of the line in turn.
+    lines = image[..., order].astype(image.dtype.newbyteorder("<"))
+    lines = lines.transpose(0, 2, 1).reshape(height, -1).view(np.uint8)
+    line_size = lines.shape[1]
+    blocks = np.empty((height, 8 + line_size), dtype=np.uint8)
+    blocks[:, :4] = np.arange(height, dtype="<i4")[:, None].view(np.uint8)
+    blocks[:, 4:8] = np.full((height, 1), line_size, dtype="<i4").view(np.uint8)
+    blocks[:, 8:] = lines
+    offsets = np.arange(height, dtype="<u8") * blocks.shape[1]
+    offsets += len(header) + 8 * height
+
+    with open(path, "wb") as f:
+        f.write(header)
+        f.write(offsets.tobytes())
+        f.write(blocks.tobytes())
+
+
+class _Batch:
+    """Images of one submit, shared by its workers, and dropped once each worker has taken its image."""
+
+    def __init__(self, images: RenderedImage | np.ndarray, count: int):
+        self._images = images
+        self._count = count
+        self._remaining = count
+        self._lock = threading.Lock()
+
+    def take(self, i: int) -> np.ndarray:
+        """Image i, waiting for the draw if needed. The view keeps only the image buffer alive, not the draw."""
+        with self._lock:
+            images = self._images
+            self._remaining -= 1
+            if self._remaining == 0:
+                self._images = None
+
+        if isinstance(images, RenderedImage):
+            images = images.numpy()
+        return images.reshape(self._count, *images.shape[-3:])[i]
+
+
+class ImageSink:
+    """
+    Writes rendered images to files on a pool of worker threads, as their draws complete, so that encoding overlaps
+    drawing and other encodes.
+
+    Workers wait for the GPU without the GIL, and encode PNG and JPEG through Pillow, whose encoders also release it, or
+    EXR as uncompressed scanlines. Each image gets the next index in submission order, and its file name is formatted
+    with it, so files are ordered regardless of completion order.
+
+    with ss.ImageSink("out", "frame_{index:05d}.png") as sink:
+        for viewmats in trajectory:
+            sink.submit(ss.draw(splats, viewmats, Ks, width, height))
+    """
+
+    def __init__(
+        self,
+        directory: str,
+        pattern: str = "{index:05d}.png",
+        workers: int | None = None,
+        max_pending: int | None = None,
+        quality: int = 95,
+        on_written: Callable[[int, str], None] | None = None,
+    ):
+        """
+        directory: created if missing.
+        pattern: file name formatted with index. The extension selects the format: ".png" and ".jpg" or ".jpeg" for
+            uint8 images, ".exr" for float16 or float32 images.
+        workers: encoding threads. Defaults to the CPU count.
+        max_pending: images submitted but not yet written, beyond which submit blocks. Defaults to 2 * workers.
+        quality: JPEG quality.
+        on_written: called with (index, path) from a worker thread after each file is written.
+        """
+        extension = os.path.splitext(pattern)[1].lower()
+        assert extension in [
+            ".png",
+            ".jpg",
+            ".jpeg",
+            ".exr",
+        ], f"unsupported {extension}"
+
+        workers = workers or os.cpu_count() or 1
+        os.makedirs(directory, exist_ok=True)
+
+        self._directory = directory
+        self._pattern = pattern
+        self._extension = extension
+        self._quality = quality
+        self._on_written = on_written
+        self._executor = ThreadPoolExecutor(workers)
+        self._pending = threading.BoundedSemaphore(max_pending or 2 * workers)
+        self._lock = threading.Lock()
+        self._error: BaseException | None = None
+        self._paths: dict[int, str] = {}
+        self._next_index = 0
+
+    def __enter__(self) -> "ImageSink":
+        return self
+
+    def __exit__(self, *exc):
+        self.close()
+
+    def submit(self, images: RenderedImage | np.ndarray) -> list[int]:
+        """
+        images: draw output of (..., H, W, C) channel-last images, C in [1, 3, 4], written one file per image. Images
+            of a DrawContext or render_stream are reused by later draws, so submit a copy of their numpy() instead.
+        Returns indices of the images. Blocks while max_pending images are not yet written. Raises ValueError for
+        planar (..., C, H, W) or other layouts, and dtypes other than uint8, float16 and float32.
+        """
+        shape = tuple(images.shape)
+        if len(shape) < 3 or shape[-1] not in [1, 3, 4]:
+            raise ValueError(
+                f"images must be (..., H, W, C) with C in [1, 3, 4], got shape {shape}"
+            )
+        if images.dtype not in [np.uint8, np.float16, np.float32]:
+            raise ValueError(
+                f"images must be uint8, float16 or float32, got {images.dtype}"
+            )
+
+        count = int(np.prod(images.shape[:-3], dtype=np.int64))
+        indices = list(range(self._next_index, self._next_index + count))
+        self._next_index += count
+
+        batch = _Batch(images, count)
+        for i, index in enumerate(indices):
+            self._pending.acquire()
+            future = self._executor.submit(self._write, batch, i, index)
+            future.add_done_callback(self._done)
+        return indices
+
+    def close(self) -> list[str]:
+        """Waits for all images to be written, and returns their paths in index order. Raises the first failure."""
+        self._executor.shutdown(wait=True)
+        if self._error is not None:
+            raise self._error
+        return [self._paths[index] for index in sorted(self._paths)]
+
+    def _done(self, future: Future):
+        # Futures are not kept, only the first failure, so that long sequences do not accumulate them.
+        error = future.exception()
+        if error is not None:
+            with self._lock:
+                if self._error is None:
+                    self._error = error
+        self._pending.release()
+
+    def _write(self, batch: _Batch, i: int, index: int):
+        image = batch.take(i)
+
+        path = os.path.join(self._directory, self._pattern.format(index=index))
+        if self._extension == ".exr":
+            assert image.dtype in [np.float16, np.float32], "EXR images are float"
+            _write_exr(path, image)
+        else:
+            from PIL import Image
+
+            assert image.dtype == np.uint8, "PNG and JPEG images are uint8"
+            if image.shape[-1] == 1:
+                image = image[..., 0]
+            if self._extension == ".png":
+                Image.fromarray(image).save(path)
+            else:
+                Image.fromarray(image[..., :3]).save(path, quality=self._quality)
+
+        self._paths[index] = path
+        if self._on_written is not None:
+            self._on_written(index, path)
@@ -1,3 +1,6 @@
+import asyncio
+import threading
+
 import numpy as np
 
 from . import _core
@@ -9,30 +12,98 @@ class RenderedImage:
         images: np.ndarray,
         shape: tuple[int],
         tasks: list[_core.RenderingTask],
+        depths: np.ndarray | None = None,
+        depth_shape: tuple[int] | None = None,
+        median_depth: bool = False,
     ):
         self._images = images
         self._shape = shape
+        self._depths = depths
+        self._depth_shape = depth_shape
+        self._median_depth = median_depth
         self._tasks = tasks
         self._done = False
+        self._lock = threading.Lock()
         self.compute_timestamps = np.zeros(len(tasks), dtype=np.uint64)
         self.graphics_timestamps = np.zeros(len(tasks), dtype=np.uint64)
         self.transfer_timestamps = np.zeros(len(tasks), dtype=np.uint64)
+        self.fragment_counts = np.zeros(len(tasks), dtype=np.uint64)
+        self.occlusion_culled_counts = np.zeros(len(tasks), dtype=np.uint32)
+        self.dropped_tile_pair_counts = np.zeros(len(tasks), dtype=np.uint32)
 
     def __del__(self):
-        self.wait()
+        self._wait()
+
+    @property
+    def shape(self) -> tuple[int, ...]:
+        return tuple(self._shape)
+
+    @property
+    def dtype(self) -> np.dtype:
+        return self._images.dtype
 
     def numpy(self) -> np.ndarray:
         self.wait()
         return self._images.reshape(*self._shape)
 
+    def alpha(self) -> np.ndarray:
+        return self._depth_output(0)
+
+    def depth(self) -> np.ndarray:
+        """Alpha-weighted expected view depth."""
+        return self._depth_output(1)
+
+    def median_depth(self) -> np.ndarray:
+        """View depth where transmittance falls below 0.5. Only computed by the "tile" rasterizer."""
+        if self._depths is not None and not self._median_depth:
+            raise RuntimeError('median depth is only computed by rasterizer="tile"')
+        return self._depth_output(2)
+
+    def _depth_output(self, channel: int) -> np.ndarray:
+        assert self._depths is not None, "draw with depth=True"
+        self.wait()
+        return self._depths.reshape(*self._depth_shape)[..., channel]
+
     def wait(self):
-        if self._done:
-            return
-
-        for i, task in enumerate(self._tasks):
-            task.wait()
-            draw_result = task.draw_result()
-            self.compute_timestamps[i] = draw_result.compute_timestamp
-            self.graphics_timestamps[i] = draw_result.graphics_timestamp
-            self.transfer_timestamps[i] = draw_result.transfer_timestamp
-        self._done = True
+        """
+        Blocks until the images are read back. The GIL is released while waiting for the GPU.
+
+        Raises RuntimeError if the "tile" rasterizer dropped tile-splat pairs over its capacity. The capacity grows
+        for later draws, so drawing again succeeds.
+        """
+        self._wait()
+        dropped = int(self.dropped_tile_pair_counts.sum())
+        if dropped > 0:
+            raise RuntimeError(
+                f"tile rasterizer dropped {dropped} pairs over capacity, draw again"
+            )
+
+    def _wait(self):
+        with self._lock:
+            if self._done:
+                return
+
+            for i, task in enumerate(self._tasks):
+                task.wait()
+                draw_result = task.draw_result()
+                self.compute_timestamps[i] = draw_result.compute_timestamp
+                self.graphics_timestamps[i] = draw_result.graphics_timestamp
+                self.transfer_timestamps[i] = draw_result.transfer_timestamp
+                self.fragment_counts[i] = draw_result.fragment_count
+                self.occlusion_culled_counts[i] = draw_result.occlusion_culled_count
+                self.dropped_tile_pair_counts[i] = draw_result.dropped_tile_pair_count
+            self._done = True
+
+    def ready(self) -> bool:
+        """Whether the GPU is done with all tasks, so that wait does not block on it. Never blocks."""
+        return self._done or all(task.ready() for task in self._tasks)
+
+    async def wait_async(self, poll_interval: float = 1e-3) -> "RenderedImage":
+        """
+        Awaitable wait, polling ready every poll_interval seconds on the running event loop, so that no executor
+        thread is held while the GPU renders. Returns self.
+        """
+        while not self.ready():
+            await asyncio.sleep(poll_interval)
+        self.wait()
+        return self
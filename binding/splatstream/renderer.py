@@ -1,3 +1,6 @@
+import asyncio
+from dataclasses import dataclass
+
 import numpy as np
 
 from . import _core
@@ -69,8 +72,60 @@ def load_from_ply(path: str, sh_degree: int = -1) -> _core.GaussianSplats:
     return singleton_engine.load_from_ply(path, sh_degree)
 
 
-def draw(
-    splats: _core.GaussianSplats,
+_RASTERIZERS = {"hardware": 0, "tile": 1, "oit": 2}
+
+# (format, dtype, channels)
+_OUTPUT_FORMATS = {
+    "rgba8": (0, np.uint8, 4),
+    "rgb8": (1, np.uint8, 3),
+    "rgba16f": (2, np.float16, 4),
+    "rgb32f": (3, np.float32, 3),
+}
+
+
+@dataclass
+class _DrawPlan:
+    """Draw options converted for the engine, with the output layout of the batch."""
+
+    options: _core.DrawOptionsBatch
+    batch_dims: tuple[int, ...]
+    near: np.ndarray
+    far: np.ndarray
+    image_shape: tuple[int, ...]
+    dtype: type
+    depth_shape: tuple[int, ...]
+    depth: bool
+    median_depth: bool
+    stereo: bool
+    occlusion_culling: bool
+    tile_size: int
+
+    def allocate(
+        self, out: np.ndarray | None = None
+    ) -> tuple[np.ndarray, np.ndarray | None]:
+        """Output images, in out if given, and depths."""
+        shape = (*self.batch_dims, *self.image_shape)
+        if out is None:
+            # Every pixel is written, and the buffer is imported as the copy destination where supported.
+            images = np.empty(shape, dtype=self.dtype)
+        else:
+            assert out.shape == shape, f"out must be of shape {shape}"
+            assert out.dtype == self.dtype, f"out must be of dtype {self.dtype}"
+            assert out.flags.c_contiguous, "out must be C-contiguous"
+            images = out
+        depths = np.empty(self.depth_shape, dtype=np.float32) if self.depth else None
+        return images, depths
+
+    def set_cameras(self, viewmats: np.ndarray, Ks: np.ndarray):
+        """Updates cameras in place, for cameras broadcasting to the batch dims."""
+        viewmats = np.broadcast_to(viewmats, (*self.batch_dims, 4, 4))
+        Ks = np.broadcast_to(Ks, (*self.batch_dims, 3, 3))
+        self.options.set_cameras(
+            viewmats.reshape(-1, 4, 4), Ks.reshape(-1, 3, 3), self.near, self.far
+        )
+
+
+def _plan(
     viewmats: np.ndarray,
     Ks: np.ndarray,
     width: int,
@@ -80,43 +135,44 @@ def draw(
     backgrounds: np.ndarray | None = None,
     eps2d: float | np.ndarray = 0.3,
     sh_degree: int | np.ndarray = -1,
-) -> RenderedImage:
-    """
-    viewmats: (..., 4, 4)
-    Ks: (..., 3, 3)
-    near: (...) or scalar
-    far: (...) or scalar
-    backgrounds: (..., 3)
-    eps2d: (...) or scalar
-    sh_degree: (...) or scalar. -1 for max degree.
-    """
-    if isinstance(near, (int, float)):
-        near = np.array(near)
-
-    if isinstance(far, (int, float)):
-        far = np.array(far)
-
-    if isinstance(eps2d, (int, float)):
-        eps2d = np.array(eps2d)
+    sh_lod_radius: float = 0.0,
+    color_cache_angle: float = 0.0,
+    rasterizer: str = "hardware",
+    front_to_back: bool = False,
+    occlusion_culling: bool = False,
+    output_format: str = "rgba8",
+    planar: bool = False,
+    srgb: bool = False,
+    depth: bool = False,
+    stereo: bool = False,
+    tile_size: int = 0,
+    roi: np.ndarray | None = None,
+) -> _DrawPlan:
+    rasterizer = _RASTERIZERS[rasterizer]
+    output_format, dtype, channels = _OUTPUT_FORMATS[output_format]
 
-    if isinstance(sh_degree, int):
-        sh_degree = np.array(sh_degree)
+    near = np.asarray(near)
+    far = np.asarray(far)
+    eps2d = np.asarray(eps2d)
+    sh_degree = np.asarray(sh_degree)
 
     if backgrounds is None:
         backgrounds = np.array([0, 0, 0])
 
+    # Zero size for the whole image.
+    if roi is None:
+        roi = np.array([0, 0, 0, 0])
+        roi_width, roi_height = width, height
+    else:
+        roi = np.asarray(roi)
+        roi_width, roi_height = int(roi[..., 2].flat[0]), int(roi[..., 3].flat[0])
+        assert np.all(roi[..., 2] == roi_width) and np.all(roi[..., 3] == roi_height)
+        assert tile_size == 0, "regions of interest are not tiled"
+
     assert viewmats.shape[-2:] == (4, 4)
     assert Ks.shape[-2:] == (3, 3)
     assert backgrounds.shape[-1:] == (3,)
-
-    # np-style view matrix (Y-down) to vulkan-style (Y-up)
-    viewmats = (
-        np.array([[1, 0, 0, 0], [0, -1, 0, 0], [0, 0, -1, 0], [0, 0, 0, 1]]) @ viewmats
-    )
-
-    # transform image space
-    # (0, 0), (W, H) -> (-1, 1), (1, -1)
-    Ks = np.array([[2.0 / width, 0, -1], [0, -2.0 / height, 1], [0, 0, 1]]) @ Ks
+    assert roi.shape[-1:] == (4,)
 
     # broadcast to batch dims
     batch_dims = np.broadcast_shapes(
@@ -127,49 +183,290 @@ def draw(
         backgrounds.shape[:-1],
         eps2d.shape,
         sh_degree.shape,
+        roi.shape[:-1],
+    )
+
+    if stereo:
+        assert batch_dims[-1:] == (2,), "stereo draws (..., 2) eye pairs"
+        assert not occlusion_culling, "occlusion culling is not applied to stereo pairs"
+
+    if tile_size > 0:
+        assert not stereo, "tiled draws do not share stereo pairs"
+        assert not occlusion_culling, "occlusion culling is not applied to tiles"
+
+    # Flattened per-view arrays. np-style to vulkan-style cameras are converted in C++.
+    near = np.broadcast_to(near, batch_dims).reshape(-1).astype(np.float32)
+    far = np.broadcast_to(far, batch_dims).reshape(-1).astype(np.float32)
+    options = _core.DrawOptionsBatch(
+        np.broadcast_to(viewmats, (*batch_dims, 4, 4)).reshape(-1, 4, 4),
+        np.broadcast_to(Ks, (*batch_dims, 3, 3)).reshape(-1, 3, 3),
+        near,
+        far,
+        width,
+        height,
+        np.broadcast_to(backgrounds, (*batch_dims, 3)).reshape(-1, 3),
+        np.broadcast_to(eps2d, batch_dims).reshape(-1),
+        np.broadcast_to(sh_degree, batch_dims).reshape(-1),
+        sh_lod_radius,
+        color_cache_angle,
+        rasterizer,
+        front_to_back,
+        occlusion_culling,
+        output_format,
+        planar,
+        srgb,
+        depth,
+        np.broadcast_to(roi, (*batch_dims, 4)).reshape(-1, 4),
     )
-    viewmats = np.broadcast_to(viewmats, (*batch_dims, 4, 4))
-    Ks = np.broadcast_to(Ks, (*batch_dims, 3, 3))
-    backgrounds = np.broadcast_to(backgrounds, (*batch_dims, 3))
-    eps2d = np.broadcast_to(eps2d, batch_dims)
-    sh_degree = np.broadcast_to(sh_degree, batch_dims)
-
-    # allocate image
-    images = np.zeros((*batch_dims, height, width, 4), dtype=np.uint8)
-
-    # np-style intrinsic to vulkan-style projection
-    projections = np.insert(Ks, 2, 0, axis=-1)
-    projections = np.insert(projections, 2, 0, axis=-2)
-    projections[..., 2, 2] = far / (near - far)
-    projections[..., 2, 3] = near * far / (near - far)
-    projections[..., 3, 2] = -1
-    projections[..., 3, 3] = 0
-
-    # flatten
-    viewmats = np.ascontiguousarray(viewmats.reshape(-1, 4, 4))
-    projections = np.ascontiguousarray(projections.reshape(-1, 4, 4))
-    backgrounds = np.ascontiguousarray(backgrounds.reshape(-1, 3))
-    eps2d = np.ascontiguousarray(eps2d.reshape(-1))
-    sh_degree = np.ascontiguousarray(sh_degree.reshape(-1))
-    images = np.ascontiguousarray(images.reshape(-1, height, width, 4))
-
-    rendered_images = []
-    for i in range(len(images)):
-        rendered_images.append(
-            singleton_engine.draw(
+
+    if planar:
+        image_shape = (channels, roi_height, roi_width)
+    else:
+        image_shape = (roi_height, roi_width, channels)
+
+    return _DrawPlan(
+        options=options,
+        batch_dims=batch_dims,
+        near=near,
+        far=far,
+        image_shape=image_shape,
+        dtype=dtype,
+        depth_shape=(*batch_dims, roi_height, roi_width, 4),
+        depth=depth,
+        median_depth=depth and rasterizer == _RASTERIZERS["tile"],
+        stereo=stereo,
+        occlusion_culling=occlusion_culling,
+        tile_size=tile_size,
+    )
+
+
+def _submit(
+    splats: _core.GaussianSplats,
+    plan: _DrawPlan,
+    images: np.ndarray,
+    depths: np.ndarray | None,
+) -> RenderedImage:
+    # flatten, as views of the contiguous outputs
+    flat_images = images.reshape(-1, *plan.image_shape)
+    flat_depths = depths.reshape(-1, *plan.depth_shape[-3:]) if plan.depth else None
+
+    if plan.tile_size > 0:
+        # One rendering task per tile of each image.
+        rendered_images = []
+        for i in range(len(flat_images)):
+            rendered_images += singleton_engine.draw_tiled(
                 splats,
-                viewmats[i],
-                projections[i],
-                width,
-                height,
-                backgrounds[i],
-                eps2d[i],
-                sh_degree[i],
-                images[i],
+                plan.options,
+                i,
+                plan.tile_size,
+                flat_images[i],
+                flat_depths[i] if plan.depth else None,
             )
+    elif plan.occlusion_culling:
+        # Each image is culled by the depth pyramid of a previous image, so draw them one by one.
+        rendered_images = []
+        for i in range(len(flat_images)):
+            rendered_images.append(
+                singleton_engine.draw(
+                    splats,
+                    plan.options,
+                    i,
+                    flat_images[i],
+                    flat_depths[i] if plan.depth else None,
+                )
+            )
+    else:
+        rendered_images = singleton_engine.draw_batch(
+            splats, plan.options, plan.stereo, flat_images, flat_depths
         )
 
-    return RenderedImage(images, (*batch_dims, height, width, 4), rendered_images)
+    return RenderedImage(
+        images,
+        (*plan.batch_dims, *plan.image_shape),
+        rendered_images,
+        depths,
+        plan.depth_shape,
+        plan.median_depth,
+    )
+
+
+def draw(
+    splats: _core.GaussianSplats,
+    viewmats: np.ndarray,
+    Ks: np.ndarray,
+    width: int,
+    height: int,
+    near: float | np.ndarray = 0.01,
+    far: float | np.ndarray = 100.0,
+    backgrounds: np.ndarray | None = None,
+    eps2d: float | np.ndarray = 0.3,
+    sh_degree: int | np.ndarray = -1,
+    sh_lod_radius: float = 0.0,
+    color_cache_angle: float = 0.0,
+    rasterizer: str = "hardware",
+    front_to_back: bool = False,
+    occlusion_culling: bool = False,
+    output_format: str = "rgba8",
+    planar: bool = False,
+    srgb: bool = False,
+    depth: bool = False,
+    stereo: bool = False,
+    tile_size: int = 0,
+    roi: np.ndarray | None = None,
+    out: np.ndarray | None = None,
+) -> RenderedImage:
+    """
+    viewmats: (..., 4, 4)
+    Ks: (..., 3, 3)
+    near: (...) or scalar
+    far: (...) or scalar
+    backgrounds: (..., 3)
+    eps2d: (...) or scalar
+    sh_degree: (...) or scalar. -1 for max degree.
+    sh_lod_radius: screen radius in pixels per evaluated SH degree. Smaller splats skip higher SH bands. 0 for all bands.
+    color_cache_angle: degrees. Splat colors are cached with their view direction, and reused by later draws viewing
+        the splat within this angle. For clusters of nearby cameras, e.g. turntables or stereo pairs. 0 disables.
+    rasterizer: "hardware" for instanced quads, "tile" for compute tile rasterizer, or "oit" for sort-free weighted
+        blended order-independent transparency, approximate but faster for previews.
+    front_to_back: "hardware" only. Blend near to far, skipping fragments of saturated pixels.
+    occlusion_culling: front_to_back only. Cull splats hidden behind saturated pixels of a previous image in the batch.
+    output_format: "rgba8", "rgb8", "rgba16f" (float16) or "rgb32f" (float32). Converted on GPU.
+    planar: channel-first (..., C, H, W) images instead of (..., H, W, C).
+    srgb: sRGB encode linear colors.
+    depth: also render alpha, expected depth and median depth in the same pass, as RenderedImage.alpha(), depth() and
+        median_depth() of shape (..., H, W). Depths are view depths, 0 where nothing is drawn. Median depth is the depth
+        where transmittance falls below 0.5, only computed by "tile", and median_depth() raises for "hardware". Not
+        supported with front_to_back or "oit".
+    stereo: the last batch dim is a (left, right) eye pair. Each pair shares one visibility and sort pass, with depth
+        from the midpoint of the eyes, and is only projected per eye. Splats close in depth may blend in a slightly
+        different order than drawing the eyes independently.
+    tile_size: if > 0, each image is drawn in square tiles of this size into one render target of tile size, and copied
+        into place. For images beyond the device render target size, e.g. gigapixel stills.
+    roi: (..., 4) region (x, y, w, h) of the (height, width) image to draw, e.g. training patches. Images are (..., h, w)
+        of the region only, with splats outside the region culled. All regions must have the same size.
+    out: C-contiguous array of the output images shape and dtype, written in place and returned by numpy() instead of
+        a new allocation. For tight loops of draws, see also DrawContext.
+    """
+    plan = _plan(
+        viewmats,
+        Ks,
+        width,
+        height,
+        near,
+        far,
+        backgrounds,
+        eps2d,
+        sh_degree,
+        sh_lod_radius,
+        color_cache_angle,
+        rasterizer,
+        front_to_back,
+        occlusion_culling,
+        output_format,
+        planar,
+        srgb,
+        depth,
+        stereo,
+        tile_size,
+        roi,
+    )
+
+    images, depths = plan.allocate(out)
+    return _submit(splats, plan, images, depths)
+
+
+def draw_async(*args, **kwargs) -> "asyncio.Future[RenderedImage]":
+    """
+    Same arguments as draw. Returns a future of the RenderedImage resolved on the running event loop once the images
+    are read back, e.g. `image = await ss.draw_async(...)`, or with future.add_done_callback.
+
+    The draw is submitted on the default executor of the loop, so that neither argument conversion nor waiting for the
+    engine lock or a ring slot blocks the loop. Completion is then awaited with RenderedImage.wait_async on the loop
+    itself, so an executor thread is only held while submitting, and many requests can be in flight at once.
+    """
+    loop = asyncio.get_running_loop()
+
+    async def draw_and_wait() -> RenderedImage:
+        rendered_image = await loop.run_in_executor(None, lambda: draw(*args, **kwargs))
+        return await rendered_image.wait_async()
+
+    return asyncio.ensure_future(draw_and_wait())
+
+
+def draw_cubemap(
+    splats: _core.GaussianSplats,
+    viewmat: np.ndarray,
+    size: int,
+    near: float = 0.01,
+    far: float = 100.0,
+    background: np.ndarray | None = None,
+    eps2d: float = 0.3,
+    sh_degree: int = -1,
+    sh_lod_radius: float = 0.0,
+    color_cache_angle: float = 0.0,
+    rasterizer: str = "hardware",
+    front_to_back: bool = False,
+    output_format: str = "rgba8",
+    planar: bool = False,
+    srgb: bool = False,
+    equirect_width: int = 0,
+) -> RenderedImage:
+    """
+    Cubemap of 90 degree (size, size) faces around the camera, drawn as one batch. With the "hardware" rasterizer
+    back-to-front, splats are classified into the faces they touch in one visibility pass, and the faces are sorted and
+    projected at once.
+
+    viewmat: (4, 4)
+    background: (3)
+    equirect_width: if > 0, faces are resampled on GPU to one equirectangular panorama of (equirect_width / 2,
+        equirect_width), with the camera forward direction at the center. Otherwise (6, size, size) faces looking right,
+        left, up, down, backward and forward of the camera, in this order.
+    Other arguments as in draw.
+    """
+    if background is None:
+        background = np.array([0, 0, 0])
+
+    assert viewmat.shape == (4, 4)
+    assert background.shape == (3,)
+
+    # Camera of 90 degree field of view, converted in C++ as in draw, and rotated to each face by the engine.
+    K = np.array([[size / 2, 0, size / 2], [0, size / 2, size / 2], [0, 0, 1]])
+    plan = _plan(
+        viewmat,
+        K,
+        size,
+        size,
+        near=near,
+        far=far,
+        backgrounds=background,
+        eps2d=eps2d,
+        sh_degree=sh_degree,
+        sh_lod_radius=sh_lod_radius,
+        color_cache_angle=color_cache_angle,
+        rasterizer=rasterizer,
+        front_to_back=front_to_back,
+        output_format=output_format,
+        planar=planar,
+        srgb=srgb,
+    )
+
+    if equirect_width > 0:
+        assert equirect_width % 2 == 0, "equirect_width must be even"
+        height, width = equirect_width // 2, equirect_width
+        batch_dims = ()
+    else:
+        height, width = size, size
+        batch_dims = (6,)
+    channels = plan.image_shape[0] if planar else plan.image_shape[-1]
+    image_shape = (channels, height, width) if planar else (height, width, channels)
+
+    images = np.empty((*batch_dims, *image_shape), dtype=plan.dtype)
+
+    rendered_images = singleton_engine.draw_cubemap(
+        splats, plan.options, 0, equirect_width, images
+    )
+
+    return RenderedImage(images, (*batch_dims, *image_shape), rendered_images)
 
 
 def show(
@@ -0,0 +1,61 @@
+import collections
+from typing import Iterable, Iterator
+
+import numpy as np
+
+from . import _core
+from .draw_context import DrawContext
+from .engine import singleton_engine
+from .rendered_image import RenderedImage
+
+
+def render_stream(
+    splats: _core.GaussianSplats,
+    cameras: Iterable[tuple[np.ndarray, np.ndarray]],
+    width: int,
+    height: int,
+    in_flight: int | None = None,
+    **kwargs,
+) -> Iterator[RenderedImage]:
+    """
+    Pipelined draws of a camera trajectory, e.g. video frames. Frames are yielded in order, each as soon as it is read
+    back, while up to in_flight later frames are drawn meanwhile. Frames rotate through the ring slots of the engine,
+    so the compute pass of a frame overlaps rendering and readback of the previous ones. Memory is bounded by
+    in_flight + 1 output buffers, reused in turn, so a yielded image is only valid until the following frame is
+    yielded. Copy it to keep it.
+
+    cameras: iterable of (viewmats, Ks) per frame, of shapes (..., 4, 4) and (..., 3, 3), with the same batch dims
+        for all frames.
+    in_flight: frames in flight, at least 1. Defaults to the ring size of the engine, one frame per ring slot.
+    kwargs: as in draw, except out, e.g. near, far, output_format or depth.
+
+    Example:
+        for frame in ss.render_stream(splats, zip(viewmats, Ks), width, height):
+            writer.write(frame.numpy())
+    """
+    if in_flight is None:
+        in_flight = singleton_engine.ring_size
+    assert in_flight >= 1
+
+    cameras = iter(cameras)
+    first = next(cameras, None)
+    if first is None:
+        return
+
+    viewmats, Ks = first
+    context = DrawContext(
+        viewmats, Ks, width, height, buffer_count=in_flight + 1, **kwargs
+    )
+    pending = collections.deque([context.draw(splats)])
+
+    for viewmats, Ks in cameras:
+        if len(pending) == in_flight:
+            rendered_image = pending.popleft()
+            rendered_image.wait()
+            yield rendered_image
+        pending.append(context.draw(splats, viewmats, Ks))
+
+    while pending:
+        rendered_image = pending.popleft()
+        rendered_image.wait()
+        yield rendered_image
@@ -14,30 +14,58 @@ namespace core {
 
 class ComputeStorageImpl {
  public:
+  // Views ranked, sorted and projected together by batched compute. Keys hold the view above this many depth bits,
+  // the float bits of depth in [0, 1] without the 4 low mantissa bits. Must match rank.comp and projection.comp.
+  // Camera and projection uniforms of all views are updated inline, within the 65536 bytes of vkCmdUpdateBuffer.
+  static constexpr uint32_t kMaxBatchViews = 64;
+  static constexpr uint32_t kBatchViewShift = 26;
+
   ComputeStorageImpl();
   ~ComputeStorageImpl();
 
   auto camera() const noexcept { return camera_; }
-  auto camera_stage() const noexcept { return camera_stage_; }
+  auto projection_uniforms() const noexcept { return projection_uniforms_; }
   auto key() const noexcept { return key_; }
   auto index() const noexcept { return index_; }
   auto sort_storage() const noexcept { return sort_storage_; }
-  auto inverse_index() const noexcept { return inverse_index_; }
+  auto workgroup_offset() const noexcept { return workgroup_offset_; }
+  auto projection_dispatch() const noexcept { return projection_dispatch_; }
+  auto batch_camera() const noexcept { return batch_camera_; }
+  auto batch_projection_uniforms() const noexcept { return batch_projection_uniforms_; }
+  auto batch_visible_point_count() const noexcept { return batch_visible_point_count_; }
+  auto batch_draw_indirect() const noexcept { return batch_draw_indirect_; }
+  auto batch_instances() const noexcept { return batch_instances_; }
 
   void Update(uint32_t point_count, VkBufferUsageFlags usage, VkDeviceSize size);
 
+  /**
+   * @brief Instances shared by the views of a batch, for pair_count visible pairs of all views.
+   */
+  void UpdateBatch(uint32_t pair_count);
+
  private:
   uint32_t point_count_ = 0;
 
   // Fixed
-  gpu::Buffer camera_;        // (Camera)
-  gpu::Buffer camera_stage_;  // (Camera)
+  gpu::Buffer camera_;               // (Camera)
+  gpu::Buffer projection_uniforms_;  // (ProjectionUniforms)
+  gpu::Buffer projection_dispatch_;  // (VkDispatchIndirectCommand)
+
+  // Fixed, batched compute
+  gpu::Buffer batch_camera_;               // (kMaxBatchViews, 4, 4), projection * view * model
+  gpu::Buffer batch_projection_uniforms_;  // (kMaxBatchViews, ProjectionUniforms)
+  gpu::Buffer batch_visible_point_count_;  // (1 + kMaxBatchViews), total then per view
+  gpu::Buffer batch_draw_indirect_;        // (kMaxBatchViews, 1 + kDrawChunkCount, DrawIndirect)
 
   // Variable
-  gpu::Buffer key_;            // (N)
-  gpu::Buffer index_;          // (N)
-  gpu::Buffer sort_storage_;   // (M)
-  gpu::Buffer inverse_index_;  // (N)
+  gpu::Buffer key_;               // (N)
+  gpu::Buffer index_;             // (N)
+  gpu::Buffer sort_storage_;      // (M)
+  gpu::Buffer workgroup_offset_;  // (ceil(N / 256))
+
+  // Variable, batched compute
+  uint32_t batch_pair_count_ = 0;
+  gpu::Buffer batch_instances_;  // (BN, 12)
 };
 
 class ComputeStorage : public SharedAccessor<ComputeStorage, ComputeStorageImpl> {};
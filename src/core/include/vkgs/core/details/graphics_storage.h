@@ -4,7 +4,12 @@
 #include <memory>
 #include <cstdint>
 
+#include <vulkan/vulkan.h>
+
+#include <glm/glm.hpp>
+
 #include "vkgs/common/shared_accessor.h"
+#include "vkgs/gpu/buffer.h"
 #include "vkgs/gpu/image.h"
 
 namespace vkgs {
@@ -12,21 +17,107 @@ namespace core {
 
 class GraphicsStorageImpl {
  public:
+  // Must match TILE_SIZE in tile.comp and local size of tile_raster.comp.
+  static constexpr uint32_t kTileSize = 16;
+
   GraphicsStorageImpl();
   ~GraphicsStorageImpl();
 
   auto image() const noexcept { return image_; }
   auto image_u8() const noexcept { return image_u8_; }
+  auto depth() const noexcept { return depth_; }
+  auto oit_accum() const noexcept { return oit_accum_; }
+  auto oit_revealage() const noexcept { return oit_revealage_; }
+  auto depth_outputs() const noexcept { return depth_outputs_; }
+
+  // Cubemap
+  auto cube_faces() const noexcept { return cube_faces_; }
+  auto equirect() const noexcept { return equirect_; }
+
+  // Depth pyramid for occlusion culling
+  auto hiz_depth() const noexcept { return hiz_depth_; }
+  auto hiz() const noexcept { return hiz_; }
+  auto hiz_level_count() const noexcept { return hiz_level_count_; }
+  auto hiz_valid() const noexcept { return hiz_valid_; }
+  const auto& hiz_view() const noexcept { return hiz_view_; }
+  const auto& hiz_projection() const noexcept { return hiz_projection_; }
+  auto hiz_screen_size() const noexcept { return glm::uvec2(width_, height_); }
+
+  // Tile rasterizer
+  auto tile_splat_count() const noexcept { return tile_splat_count_; }
+  auto tile_dispatch() const noexcept { return tile_dispatch_; }
+  auto tile_ranges() const noexcept { return tile_ranges_; }
+  auto tile_keys() const noexcept { return tile_keys_; }
+  auto tile_values() const noexcept { return tile_values_; }
+  auto tile_sort_storage() const noexcept { return tile_sort_storage_; }
+  auto tile_workgroup_offset() const noexcept { return tile_workgroup_offset_; }
+  auto tile_capacity() const noexcept { return tile_capacity_; }
 
   void Update(uint32_t width, uint32_t height);
 
+  /**
+   * @brief Marks the depth pyramid as built with the camera, for the next frame in this slot.
+   */
+  void SetHiz(const glm::mat4& view, const glm::mat4& projection) {
+    hiz_view_ = view;
+    hiz_projection_ = projection;
+    hiz_valid_ = true;
+  }
+  void InvalidateHiz() { hiz_valid_ = false; }
+
+  /**
+   * @brief Allocates the depth outputs image at the current size, on first use.
+   */
+  void UpdateDepthOutputs();
+
+  /**
+   * @brief Allocates the six cube faces at the current size and the equirectangular image, on first use or resize.
+   */
+  void UpdateCubemap(uint32_t equirect_width, uint32_t equirect_height);
+
+  /**
+   * @brief Allocates tile rasterizer buffers, with tile-splat pair capacity and its sort storage.
+   */
+  void UpdateTiles(uint32_t point_count, uint32_t tile_capacity, VkBufferUsageFlags usage, VkDeviceSize size);
+
  private:
   uint32_t width_ = 0;
   uint32_t height_ = 0;
+  uint32_t point_count_ = 0;
+  uint32_t tile_capacity_ = 0;
 
   // Variable
   gpu::Image image_;     // (H, W, 4) float32
   gpu::Image image_u8_;  // (H, W, 4), UNORM
+  gpu::Image depth_;     // (H, W), saturated pixels for front-to-back blending
+
+  // Weighted blended order-independent transparency
+  gpu::Image oit_accum_;      // (H, W, 4), weighted sum of pre-multiplied color
+  gpu::Image oit_revealage_;  // (H, W), sum of -log(1 - alpha)
+
+  // Auxiliary outputs, allocated on first use
+  gpu::Image depth_outputs_;  // (H, W, 4) float32, (alpha, expected depth, median depth, 0)
+
+  // Cubemap, allocated on first use
+  gpu::Buffer cube_faces_;  // (6, H, W, 4) float16
+  gpu::Image equirect_;     // (H', W', 4) float16
+
+  // Depth pyramid
+  gpu::Buffer hiz_depth_;  // (H, W), copy of depth
+  gpu::Buffer hiz_;        // (L, ceil(H / 2^(l+1)), ceil(W / 2^(l+1)), 2), (min, max) per level
+  uint32_t hiz_level_count_ = 0;
+  bool hiz_valid_ = false;
+  glm::mat4 hiz_view_;
+  glm::mat4 hiz_projection_;
+
+  // Tile rasterizer
+  gpu::Buffer tile_splat_count_;       // (2), pair count clamped to capacity, and requested pair count.
+  gpu::Buffer tile_dispatch_;          // (VkDispatchIndirectCommand)
+  gpu::Buffer tile_ranges_;            // (T, 2)
+  gpu::Buffer tile_keys_;              // (C)
+  gpu::Buffer tile_values_;            // (C)
+  gpu::Buffer tile_sort_storage_;      // (M)
+  gpu::Buffer tile_workgroup_offset_;  // (ceil(N / 256))
 };
 
 class GraphicsStorage : public SharedAccessor<GraphicsStorage, GraphicsStorageImpl> {};
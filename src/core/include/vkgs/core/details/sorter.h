@@ -1,27 +1,141 @@
 #ifndef VKGS_CORE_DETAILS_SORTER_H
 #define VKGS_CORE_DETAILS_SORTER_H
 
+#include <cstdint>
+#include <memory>
+
+#include <vulkan/vulkan.h>
+
 #include "vk_radix_sort.h"
 
 #include "vkgs/common/shared_accessor.h"
+#include "vkgs/gpu/pipeline_layout.h"
+#include "vkgs/gpu/compute_pipeline.h"
+
+#include "vkgs/core/export_api.h"
 
 namespace vkgs {
 namespace core {
 
-class SorterImpl {
+enum class SorterType {
+  AUTO,
+  RADIX,
+  BITONIC,
+};
+
+struct SorterStorageRequirements {
+  VkDeviceSize size;
+  VkBufferUsageFlags usage;
+};
+
+/**
+ * @brief Sorts (uint32 key, uint32 value) pairs in ascending key order, with element count read from a GPU buffer.
+ *
+ * Sorts are stable, so that equal keys keep input order whichever sorter AutoSorterImpl selects.
+ */
+class VKGS_CORE_API SorterImpl {
  public:
-  explicit SorterImpl(VkDevice device, VkPhysicalDevice physical_device);
-  ~SorterImpl();
+  SorterImpl();
+  virtual ~SorterImpl();
+
+  /**
+   * @brief Whether the sorter can sort up to max_size elements.
+   */
+  virtual bool Supports(size_t max_size) const = 0;
+
+  virtual SorterStorageRequirements GetStorageRequirements(size_t max_size) const = 0;
+  virtual void SortKeyValueIndirect(VkCommandBuffer cb, size_t max_size, VkBuffer size, VkBuffer key, VkBuffer value,
+                                    VkBuffer storage) const = 0;
+};
 
-  VrdxSorterStorageRequirements GetStorageRequirements(size_t max_size) const;
+/**
+ * @brief Multi-pass radix sort by vk_radix_sort. Supports any size.
+ */
+class VKGS_CORE_API RadixSorterImpl : public SorterImpl {
+ public:
+  RadixSorterImpl(VkDevice device, VkPhysicalDevice physical_device);
+  ~RadixSorterImpl() override;
+
+  bool Supports(size_t max_size) const override { return true; }
+
+  SorterStorageRequirements GetStorageRequirements(size_t max_size) const override;
   void SortKeyValueIndirect(VkCommandBuffer cb, size_t max_size, VkBuffer size, VkBuffer key, VkBuffer value,
-                            VkBuffer storage) const;
+                            VkBuffer storage) const override;
+
+  void SortKeyValueIndirect(VkCommandBuffer cb, size_t max_size, VkBuffer size, VkDeviceSize size_offset,
+                            VkBuffer key, VkBuffer value, VkBuffer storage, VkDeviceSize storage_offset) const;
 
  private:
   VrdxSorter sorter_ = VK_NULL_HANDLE;
 };
 
-class Sorter : public SharedAccessor<Sorter, SorterImpl> {};
+/**
+ * @brief Single-workgroup bitonic sort in shared memory, one dispatch.
+ *
+ * Keys are sorted with input positions as tie-break for stability, and values gathered by position afterwards.
+ * Available only if the device has enough shared memory for kCapacity key-position pairs.
+ */
+class VKGS_CORE_API BitonicSorterImpl : public SorterImpl {
+ public:
+  // Must match CAPACITY in sort_bitonic.comp.
+  static constexpr uint32_t kCapacity = 4096;
+
+  BitonicSorterImpl(VkDevice device, VkPhysicalDevice physical_device);
+  ~BitonicSorterImpl() override;
+
+  bool available() const noexcept { return available_; }
+
+  bool Supports(size_t max_size) const override { return available_ && max_size <= kCapacity; }
+
+  SorterStorageRequirements GetStorageRequirements(size_t max_size) const override;
+  void SortKeyValueIndirect(VkCommandBuffer cb, size_t max_size, VkBuffer size, VkBuffer key, VkBuffer value,
+                            VkBuffer storage) const override;
+
+ private:
+  bool available_ = false;
+  gpu::PipelineLayout pipeline_layout_;
+  gpu::ComputePipeline pipeline_;
+};
+
+/**
+ * @brief Selects a sorter by element count, among the ones the device supports.
+ *
+ * Small sizes avoid the fixed multi-dispatch cost of radix sort with a single-workgroup bitonic sort. If max_size is
+ * beyond bitonic capacity, the choice is made on GPU from the element count: both sorts are recorded, and the one not
+ * taken sorts 0 elements.
+ */
+class VKGS_CORE_API AutoSorterImpl : public SorterImpl {
+ public:
+  AutoSorterImpl(VkDevice device, VkPhysicalDevice physical_device);
+  ~AutoSorterImpl() override;
+
+  bool Supports(size_t max_size) const override { return true; }
+
+  SorterStorageRequirements GetStorageRequirements(size_t max_size) const override;
+  void SortKeyValueIndirect(VkCommandBuffer cb, size_t max_size, VkBuffer size, VkBuffer key, VkBuffer value,
+                            VkBuffer storage) const override;
+
+  const SorterImpl* Select(size_t max_size) const;
+
+ private:
+  // Storage layout of the GPU-selected path: bitonic count, radix count, then radix storage, each at an offset
+  // aligned to any minStorageBufferOffsetAlignment. Must match RADIX_COUNT_INDEX in sort_split.comp.
+  static constexpr VkDeviceSize kRadixCountOffset = 256;
+  static constexpr VkDeviceSize kRadixStorageOffset = 512;
+
+  // Whether the sorter is chosen on GPU from the element count.
+  bool SelectsOnDevice(size_t max_size) const;
+
+  std::shared_ptr<RadixSorterImpl> radix_;
+  std::shared_ptr<BitonicSorterImpl> bitonic_;
+  gpu::PipelineLayout split_pipeline_layout_;
+  gpu::ComputePipeline split_pipeline_;
+};
+
+class VKGS_CORE_API Sorter : public SharedAccessor<Sorter, SorterImpl> {
+ public:
+  static Sorter Create(SorterType type, VkDevice device, VkPhysicalDevice physical_device);
+};
 
 }  // namespace core
 }  // namespace vkgs
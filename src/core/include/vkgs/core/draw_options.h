@@ -6,6 +6,19 @@
 namespace vkgs {
 namespace core {
 
+enum class Rasterizer {
+  HARDWARE,  // Instanced quads with fixed-function blending.
+  TILE,      // Compute rasterizer with per-tile front-to-back blending.
+  OIT,       // Sort-free weighted blended order-independent transparency. Approximate, for previews.
+};
+
+enum class OutputFormat {
+  RGBA8,    // Blitted and copied on the transfer queue, unless planar or sRGB.
+  RGB8,     // Others are converted by a compute pass straight into the readback buffer.
+  RGBA16F,
+  RGB32F,
+};
+
 struct DrawOptions {
   glm::mat4 view;
   glm::mat4 projection;
@@ -15,7 +28,24 @@ struct DrawOptions {
   glm::vec3 background;
   float eps2d;
   int sh_degree;
+  float sh_lod_radius;      // Screen radius in pixels per evaluated SH degree, smaller splats skip bands. 0 for all.
+  float color_cache_angle;  // Degrees. Splat colors are reused within this angle of their cached view direction.
   bool record_stat;
+  bool generic_projection;  // Debug. Branches on SH and opacity degrees at runtime instead of specialized pipelines.
+  bool deterministic;  // Visible splats are ranked in point order, so that sort results are reproducible.
+  Rasterizer rasterizer;
+  bool front_to_back;      // HARDWARE only. Splats are blended near to far, saturated pixels reject later fragments.
+  bool occlusion_culling;  // front_to_back only. Splats hidden in the previous frame of the ring slot are culled.
+  OutputFormat output_format;
+  bool output_planar;  // Channel planes (C, H, W) instead of interleaved (H, W, C).
+  bool output_srgb;    // sRGB encoding of linear colors.
+  // Also renders (alpha, expected depth, median depth, 0) as (H, W, 4) float32 in the same pass. Depth is view depth,
+  // expected depth is alpha-weighted. Median depth, where transmittance falls below 0.5, needs splats blended in order
+  // per pixel, so it is only computed by TILE, and is NaN for HARDWARE. Not supported with front_to_back or OIT.
+  bool output_depth;
+  // (x, y, width, height) region of the width x height image, drawn as an image of the region size with the projection
+  // cropped to it. Zero size for the whole image.
+  glm::uvec4 roi;
 };
 
 }  // namespace core
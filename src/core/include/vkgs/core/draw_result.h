@@ -7,9 +7,12 @@ namespace vkgs {
 namespace core {
 
 struct DrawResult {
-  uint64_t compute_timestamp;
+  uint64_t compute_timestamp;  // End of the compute pass, shared by the views of a batched compute pass.
   uint64_t graphics_timestamp;
   uint64_t transfer_timestamp;
+  uint64_t fragment_count;  // Splat fragment shader invocations, 0 if not available.
+  uint32_t occlusion_culled_count;  // Splats culled by the depth pyramid of the previous frame.
+  uint32_t dropped_tile_pair_count;  // Tile-splat pairs over capacity, not rasterized by the tile rasterizer.
 };
 
 }  // namespace core
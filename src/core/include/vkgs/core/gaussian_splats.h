@@ -28,9 +28,15 @@ class VKGS_CORE_API GaussianSplatsImpl {
   auto sh() const noexcept { return sh_; }
   auto opacity_sh() const noexcept { return opacity_sh_; }
   auto index_buffer() const noexcept { return index_buffer_; }
+  auto color_cache() const noexcept { return color_cache_; }
+
+  void SetColorCache(gpu::Buffer color_cache) { color_cache_ = color_cache; }
 
   void Wait();
 
+  /** @brief Waits for the upload only. Wait still runs completion callbacks, and must be serialized with recording. */
+  void WaitFence();
+
  private:
   size_t size_;
   uint32_t sh_degree_;
@@ -40,6 +46,7 @@ class VKGS_CORE_API GaussianSplatsImpl {
   gpu::Buffer sh_;                // (N, K) float16
   gpu::Buffer opacity_sh_;        // (N, K) float16
   gpu::Buffer index_buffer_;      // (N, 6)
+  gpu::Buffer color_cache_;       // (N, 8) float16, view-dependent colors created by the first draw using them.
   gpu::QueueTask task_;
 };
 
@@ -1,20 +1,27 @@
 #ifndef VKGS_CORE_RENDERER_H
 #define VKGS_CORE_RENDERER_H
 
-#include <array>
+#include <atomic>
 #include <cstdint>
+#include <map>
 #include <memory>
 #include <string>
+#include <tuple>
 #include <vector>
 
 #include <vulkan/vulkan.h>
 
+#include <glm/glm.hpp>
+
 #include "vkgs/common/shared_accessor.h"
 #include "vkgs/gpu/pipeline_layout.h"
 #include "vkgs/gpu/compute_pipeline.h"
 #include "vkgs/gpu/semaphore.h"
 #include "vkgs/gpu/timer.h"
+#include "vkgs/gpu/pipeline_statistics.h"
 #include "vkgs/gpu/buffer.h"
+#include "vkgs/gpu/image.h"
+#include "vkgs/gpu/queue_task.h"
 
 #include "vkgs/core/export_api.h"
 #include "vkgs/core/draw_options.h"
@@ -35,20 +42,84 @@ struct RenderTargetOptions {
   std::vector<VkFormat> formats;
   std::vector<uint32_t> locations;
   VkFormat depth_format;
+  bool depth_outputs;  // Splat color also writes blended (alpha, depth * alpha, 0, alpha) to location 1.
 };
 
 class VKGS_CORE_API RendererImpl {
  public:
-  RendererImpl();
+  static constexpr uint32_t kMinRingSize = 2;
+  static constexpr uint32_t kMaxRingSize = 8;
+
+  /**
+   * @brief Renderer with ring_size frames in flight, each with its own storages. Draws and chunks of batch draws
+   * rotate through separate rings of this size.
+   *
+   * Deeper rings overlap more queue stages of consecutive draws, at the cost of one set of storages per frame.
+   */
+  explicit RendererImpl(uint32_t ring_size = kMinRingSize);
   ~RendererImpl();
 
   const std::string& device_name() const noexcept { return device_name_; }
   uint32_t graphics_queue_index() const noexcept { return graphics_queue_index_; }
   uint32_t compute_queue_index() const noexcept { return compute_queue_index_; }
   uint32_t transfer_queue_index() const noexcept { return transfer_queue_index_; }
+  uint32_t ring_size() const noexcept { return ring_buffer_.size(); }
 
+  /**
+   * @brief Draw into dst, and depth outputs into depth_dst if requested by draw options.
+   */
   RenderingTask Draw(GaussianSplats splats, const DrawOptions& draw_options,
-                     const ScreenSplatOptions& screen_splat_options, uint8_t* dst);
+                     const ScreenSplatOptions& screen_splat_options, uint8_t* dst, float* depth_dst = nullptr);
+
+  /**
+   * @brief Draw views of the same size and output format into dst of B consecutive images, with one rendering task
+   * per view.
+   *
+   * Views are recorded kBatchChunkSize at a time into one compute and one graphics command buffer, sharing the storages
+   * of a batch ring slot and pipelines. Occlusion culling is not applied, as all views of a chunk are computed before any is rendered.
+   *
+   * Views drawn by the hardware rasterizer back-to-front, without deterministic ranks, stats or color cache, share one
+   * rank, sort and projection per chunk of up to ComputeStorageImpl::kMaxBatchViews views instead. See
+   * ComputeScreenSplatsBatch.
+   */
+  std::vector<RenderingTask> DrawBatch(GaussianSplats splats, const std::vector<DrawOptions>& draw_options,
+                                       const ScreenSplatOptions& screen_splat_options, uint8_t* dst,
+                                       float* depth_dst = nullptr);
+
+  /**
+   * @brief DrawBatch of stereo pairs, (left, right) consecutive in draw options.
+   *
+   * Each pair is ranked and sorted once, by visibility in either eye and depth from the midpoint of the eyes, and only
+   * projected per eye. Splats overlapping in depth may blend in a slightly different order than independent sorts.
+   */
+  std::vector<RenderingTask> DrawStereo(GaussianSplats splats, const std::vector<DrawOptions>& draw_options,
+                                        const ScreenSplatOptions& screen_splat_options, uint8_t* dst,
+                                        float* depth_dst = nullptr);
+
+  /**
+   * @brief Draw an image of any size into dst in square tiles of tile_size, as DrawBatch of the tiles with one
+   * rendering task per tile.
+   *
+   * Each tile crops the projection, so the rank pass culls splats outside its frustum, and is rendered into one target
+   * of tile size reused by all tiles. Tiles are read back in chunks and copied into place in dst by the host, so memory
+   * is bounded by the tile size, not the image size.
+   */
+  std::vector<RenderingTask> DrawTiled(GaussianSplats splats, const DrawOptions& draw_options,
+                                       const ScreenSplatOptions& screen_splat_options, uint8_t* dst, float* depth_dst,
+                                       uint32_t tile_size);
+
+  /**
+   * @brief Draw the six 90 degree faces of a cubemap around the camera of draw options, in +X, -X, +Y, -Y, +Z, -Z
+   * order of camera space, as DrawBatch of square views with one rendering task per face. Faces supporting batched
+   * compute share one rank, sort and projection, also when resampled. See ComputeScreenSplatsBatch.
+   *
+   * With equirect_width, the faces are resampled in the same submission to one equirectangular panorama of
+   * (equirect_width / 2, equirect_width) in the output format of draw options, with one rendering task. Near, far and
+   * axis signs of the projection are kept, its field of view is not.
+   */
+  std::vector<RenderingTask> DrawCubemap(GaussianSplats splats, const DrawOptions& draw_options,
+                                         const ScreenSplatOptions& screen_splat_options, uint8_t* dst,
+                                         uint32_t equirect_width = 0);
 
   // Low-level API
   /**
@@ -67,21 +138,199 @@ class VKGS_CORE_API RendererImpl {
                                const ScreenSplatOptions& screen_splat_options,
                                const RenderTargetOptions& render_target_options);
 
+  /**
+   * @brief Record front-to-back rendering of screen splats in chunks, with its own render pass.
+   *
+   * Pixels saturated after each chunk are marked in the depth buffer, so later chunks skip their fragments. The image
+   * is left in rendering local read layout, and matches RenderScreenSplatsColor on a target cleared to (background, 0).
+   */
+  void RenderScreenSplatsFrontToBack(VkCommandBuffer command_buffer, ScreenSplats screen_splats,
+                                     const DrawOptions& draw_options, const ScreenSplatOptions& screen_splat_options,
+                                     GraphicsStorage graphics_storage,
+                                     gpu::PipelineStatistics fragment_statistics = {});
+
+  /**
+   * @brief Record sort-free weighted blended order-independent transparency of screen splats, with its own render pass.
+   *
+   * Approximates RenderScreenSplatsColor on a target cleared to (background, 0), in any splat order. The image is left
+   * in rendering local read layout.
+   */
+  void RenderScreenSplatsOit(VkCommandBuffer command_buffer, ScreenSplats screen_splats,
+                             const DrawOptions& draw_options, const ScreenSplatOptions& screen_splat_options,
+                             GraphicsStorage graphics_storage, gpu::PipelineStatistics fragment_statistics = {});
+
+  /**
+   * @brief Record tile binning and compute rasterization of screen splats into a storage image in general layout.
+   *
+   * The output matches RenderScreenSplatsColor on a target cleared to (background, 0). Depth outputs are written to
+   * their image in general layout too, if requested by draw options.
+   *
+   * Tile-splat pairs are stored up to a capacity of kTilePairsPerPoint per point, or the demand of earlier draws, and
+   * at most kMaxTilePairCapacity. Pairs over capacity are dropped. If tile_pair_count is given, the (stored, requested)
+   * pair counts are copied to it for the draw result, which raises the capacity of later draws to the requested count.
+   */
+  void RasterizeScreenSplatsTile(VkCommandBuffer command_buffer, ScreenSplats screen_splats, size_t point_count,
+                                 const DrawOptions& draw_options, const ScreenSplatOptions& screen_splat_options,
+                                 GraphicsStorage graphics_storage, gpu::Buffer tile_pair_count = {});
+
  private:
+  // Placement of the views of a tiled draw in one image of width and height.
+  struct TiledOutput {
+    uint32_t width;
+    uint32_t height;
+    std::vector<glm::uvec4> regions;  // (x, y, width, height) of the image covered by each view, at the view origin.
+  };
+
+  /**
+   * @brief DrawBatch, or DrawStereo if stereo. With tiled output, views are copied into place in dst instead.
+   */
+  std::vector<RenderingTask> DrawViews(GaussianSplats splats, const std::vector<DrawOptions>& draw_options,
+                                       const ScreenSplatOptions& screen_splat_options, uint8_t* dst, float* depth_dst,
+                                       bool stereo, const TiledOutput* tiled_output = nullptr);
+
+  /**
+   * @brief Compute screen splats with the given storages, without queue ownership transfers.
+   *
+   * With stereo options, draw options and stereo options are the two eyes of a stereo pair. Visibility and sort are
+   * computed once for both, and only projection is per eye, into stereo screen splats for the second.
+   */
+  void ComputeScreenSplats(VkCommandBuffer command_buffer, GaussianSplats splats, const DrawOptions& draw_options,
+                           ScreenSplats screen_splats, ComputeStorage compute_storage,
+                           GraphicsStorage graphics_storage, gpu::Timer timer,
+                           const DrawOptions* stereo_options = nullptr, ScreenSplats stereo_screen_splats = {});
+
+  /**
+   * @brief Compute screen splats of views with the given storage in one rank, sort and projection dispatch each.
+   *
+   * Views are ranked in the y dimension of the grid into one range, with keys of the view above the float bits of
+   * depth, so that one sort groups pairs by view in depth order. Depths keep 19 of 23 mantissa bits, so splats within
+   * a relative depth of 2^-19 may blend in a different order than in a single view draw. Screen splats of the views share the instances of the storage,
+   * and their draws start at the first instance of the view.
+   */
+  void ComputeScreenSplatsBatch(VkCommandBuffer command_buffer, GaussianSplats splats,
+                                const std::vector<DrawOptions>& draw_options,
+                                const std::vector<ScreenSplats>& screen_splats, ComputeStorage compute_storage,
+                                gpu::Timer timer);
+
+  /**
+   * @brief Record rendering of screen splats with the rasterizer of draw options, blitted to the uint8 image.
+   *
+   * The uint8 image is left in transfer dst layout. If the output is converted instead, the float image is left in
+   * general layout for ConvertOutput. Depth outputs, if requested, are left in transfer src layout. The depth pyramid
+   * is built if requested, but not released. Tile pair counts are copied to tile_pair_count if given, see
+   * RasterizeScreenSplatsTile.
+   */
+  void RenderScreenSplatsImage(VkCommandBuffer command_buffer, ScreenSplats screen_splats, size_t point_count,
+                               const DrawOptions& draw_options, const ScreenSplatOptions& screen_splat_options,
+                               GraphicsStorage graphics_storage, gpu::PipelineStatistics fragment_statistics,
+                               gpu::Buffer tile_pair_count = {});
+
+  /**
+   * @brief Record conversion of the float image in general layout to the output format of draw options, at
+   * byte_offset of buffer.
+   *
+   * Outputs larger than the storage buffer range are converted by several dispatches.
+   */
+  void ConvertOutput(VkCommandBuffer command_buffer, gpu::Image image, const DrawOptions& draw_options,
+                     gpu::Buffer buffer, VkDeviceSize byte_offset);
+
+  /**
+   * @brief Record copy of depth outputs in transfer src layout, at byte_offset of buffer.
+   */
+  void CopyDepthOutputs(VkCommandBuffer command_buffer, GraphicsStorage graphics_storage,
+                        const DrawOptions& draw_options, VkBuffer buffer, VkDeviceSize byte_offset);
+
+  /**
+   * @brief Record depth pyramid reduction of the front-to-back depth buffer, for occlusion culling in the next frame.
+   */
+  void BuildHiz(VkCommandBuffer command_buffer, GraphicsStorage graphics_storage);
+
+  /**
+   * @brief Projection pipeline specialized for the degrees of splat data and color cache, created on first use.
+   *
+   * kDynamicDegree reads the degree at runtime instead. Batch projects views of ComputeScreenSplatsBatch.
+   */
+  gpu::ComputePipeline GetProjectionPipeline(int sh_degree, int opacity_degree, bool color_cache, bool batch = false);
+
+  // Host visible buffers reused by the draws or chunks of a ring slot, one per submission in flight. Each is valid once
+  // the task of its previous submission is done, and is reserved until then.
+  struct ReadbackPool {
+    static constexpr size_t kMaxBufferCount = 4;
+
+    std::vector<gpu::Buffer> buffers;
+    std::vector<gpu::QueueTask> tasks;  // Empty while reserved for a submission being recorded.
+  };
+
+  // Destination of image copies, and whether the host still has to copy it to dst.
+  struct Readback {
+    gpu::Buffer buffer;
+    VkDeviceSize offset;
+    bool imported;
+    int pool_index = -1;  // Index of the pooled buffer, or -1 if not pooled.
+  };
+
+  /**
+   * @brief Readback of size bytes into dst, imported as host memory so that images are copied to dst directly.
+   *
+   * dst and size must be aligned to texel_size for import, 4 for converted outputs. Falls back to a pooled buffer whose
+   * previous submission is done if dst is null or cannot be imported. Rather than waiting, another buffer is added to
+   * the pool if all are in use, or allocated for this submission only once the pool is full.
+   */
+  Readback GetReadback(uint8_t* dst, VkDeviceSize size, VkDeviceSize texel_size, ReadbackPool& pool);
+
+  /**
+   * @brief Releases the pooled buffer of readback, if any, for reuse once task is done.
+   */
+  void KeepReadback(const Readback& readback, ReadbackPool& pool, gpu::QueueTask task);
+
   std::string device_name_;
   uint32_t graphics_queue_index_;
   uint32_t compute_queue_index_;
   uint32_t transfer_queue_index_;
+  bool pipeline_statistics_query_;
+  uint32_t max_image_size_;
 
   Sorter sorter_;
+  Sorter tile_sorter_;
+
+  // Tile-splat pair capacity requested by earlier draws, raised by draw callbacks.
+  std::shared_ptr<std::atomic<uint64_t>> tile_pair_demand_ = std::make_shared<std::atomic<uint64_t>>(0);
 
   gpu::PipelineLayout compute_pipeline_layout_;
   gpu::ComputePipeline rank_pipeline_;
-  gpu::ComputePipeline inverse_index_pipeline_;
-  gpu::ComputePipeline projection_pipeline_;
+  gpu::ComputePipeline rank_count_pipeline_;
+  gpu::ComputePipeline rank_scan_pipeline_;
+  gpu::ComputePipeline rank_deterministic_pipeline_;
+  gpu::ComputePipeline rank_occlusion_pipeline_;
+  gpu::ComputePipeline rank_count_occlusion_pipeline_;
+  gpu::ComputePipeline rank_deterministic_occlusion_pipeline_;
+  gpu::ComputePipeline rank_stereo_pipeline_;
+  gpu::ComputePipeline rank_count_stereo_pipeline_;
+  gpu::ComputePipeline rank_deterministic_stereo_pipeline_;
+  gpu::ComputePipeline rank_batch_pipeline_;
+  gpu::ComputePipeline indirect_pipeline_;
+  gpu::ComputePipeline indirect_batch_pipeline_;
+  std::map<std::tuple<int, int, bool, bool>, gpu::ComputePipeline> projection_pipelines_;
   gpu::ComputePipeline projection_float_pipeline_;
 
   gpu::PipelineLayout graphics_pipeline_layout_;
+  gpu::PipelineLayout screen_pipeline_layout_;
+
+  gpu::PipelineLayout output_pipeline_layout_;
+  gpu::ComputePipeline output_pipeline_;
+  gpu::ComputePipeline depth_resolve_pipeline_;
+  gpu::ComputePipeline equirect_pipeline_;
+
+  gpu::PipelineLayout hiz_pipeline_layout_;
+  gpu::ComputePipeline hiz_pipeline_;
+
+  gpu::PipelineLayout tile_pipeline_layout_;
+  gpu::ComputePipeline tile_count_pipeline_;
+  gpu::ComputePipeline tile_scan_pipeline_;
+  gpu::ComputePipeline tile_emit_pipeline_;
+  gpu::ComputePipeline tile_range_pipeline_;
+  gpu::ComputePipeline tile_raster_pipeline_;
+  gpu::ComputePipeline tile_raster_depth_outputs_pipeline_;
 
   struct RingBuffer {
     ComputeStorage compute_storage;
@@ -90,10 +339,33 @@ class VKGS_CORE_API RendererImpl {
     gpu::Semaphore compute_semaphore;
     gpu::Semaphore graphics_semaphore;
     gpu::Semaphore transfer_semaphore;
+    ReadbackPool readback;
+    ReadbackPool depth_readback;
+  };
+  std::vector<RingBuffer> ring_buffer_;
+
+  // Views recorded per submission by DrawBatch, each with its own screen splats. Even for stereo pairs, and holds the
+  // faces of a cubemap.
+  static constexpr uint32_t kBatchChunkSize = 6;
+
+  // Upper bound of visible pairs over the views of a chunk of batched compute, i.e. views times points. Views sharing
+  // instances hold 48 bytes per pair.
+  static constexpr uint32_t kBatchPairCapacity = 1 << 23;
+
+  struct BatchBuffer {
+    ComputeStorage compute_storage;
+    std::vector<ScreenSplats> screen_splats;  // At least kBatchChunkSize, grown for batched compute.
+    GraphicsStorage graphics_storage;
+    gpu::Semaphore compute_semaphore;
+    gpu::Semaphore graphics_semaphore;
+    ReadbackPool readback;
+    ReadbackPool depth_readback;
   };
-  std::array<RingBuffer, 2> ring_buffer_;
+  // Ring of ring size slots, one per chunk of DrawBatch or DrawCubemap in flight.
+  std::vector<BatchBuffer> batch_buffer_;
 
   uint64_t frame_index_ = 0;
+  uint64_t batch_index_ = 0;
 };
 
 class Renderer : public SharedAccessor<Renderer, RendererImpl> {};
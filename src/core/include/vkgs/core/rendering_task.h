@@ -24,6 +24,12 @@ class VKGS_CORE_API RenderingTaskImpl {
 
   void Wait();
 
+  /** @brief Waits for the GPU only. Wait still runs completion callbacks, and must be serialized with recording. */
+  void WaitFence();
+
+  /** @brief Whether WaitFence would return without blocking. */
+  bool IsFenceSignaled();
+
  private:
   gpu::QueueTask task_;
   DrawResult result_ = {};
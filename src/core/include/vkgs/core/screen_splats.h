@@ -16,6 +16,9 @@ namespace core {
 
 class VKGS_CORE_API ScreenSplatsImpl {
  public:
+  // Number of chunked draws after the full draw in draw_indirect. Must match CHUNK_COUNT in indirect.comp.
+  static constexpr uint32_t kDrawChunkCount = 8;
+
   ScreenSplatsImpl();
   ~ScreenSplatsImpl();
 
@@ -32,13 +35,18 @@ class VKGS_CORE_API ScreenSplatsImpl {
   // Internal
   void Update(uint32_t point_count);
 
+  /**
+   * @brief Use instances of batched compute, shared with other views from the first instance of the draws.
+   */
+  void SetInstances(gpu::Buffer instances);
+
  private:
   uint32_t point_count_ = 0;
   glm::mat4 projection_;
 
   // Fixed
   gpu::Buffer visible_point_count_;  // (1)
-  gpu::Buffer draw_indirect_;        // (DrawIndirect)
+  gpu::Buffer draw_indirect_;        // (1 + kDrawChunkCount, DrawIndirect), full draw then chunks in rank order
   gpu::Buffer stats_;                // (Stats)
 
   // Variable
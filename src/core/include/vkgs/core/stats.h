@@ -9,6 +9,7 @@ namespace core {
 struct Stats {
   uint32_t histogram_alpha[64];
   uint32_t histogram_projection_active_threads[64];  // array index i means i+1 threads are active
+  uint32_t occlusion_culled_count;
 };
 
 }  // namespace core
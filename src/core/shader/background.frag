@@ -0,0 +1,13 @@
+#version 460 core
+
+// Background under front-to-back blended splats. Alpha is kept, as in back-to-front blending onto (background, 0).
+
+layout(std430, push_constant) uniform ScreenPushConstants {
+  vec4 background;
+  float saturation_alpha;
+  uint chunk;
+};
+
+layout(location = 0) out vec4 out_color;
+
+void main() { out_color = vec4(background.rgb, 0.f); }
@@ -0,0 +1,15 @@
+#version 460 core
+
+// Resolves weighted blended order-independent transparency into pre-multiplied alpha, blended over (background, 0).
+
+layout(input_attachment_index = 0, binding = 0) uniform subpassInput accum_image;
+layout(input_attachment_index = 1, binding = 3) uniform subpassInput revealage_image;
+
+layout(location = 0) out vec4 out_color;
+
+void main() {
+  vec4 accum = subpassLoad(accum_image);
+  float alpha = 1.f - exp(-subpassLoad(revealage_image).r);
+  vec3 color = accum.rgb / max(accum.a, 1e-5f);
+  out_color = vec4(color * alpha, alpha);
+}
@@ -0,0 +1,16 @@
+#version 460 core
+
+// Marks pixels saturated by front-to-back blending, by writing the depth of saturate.vert so that later splat fragments
+// fail the early depth test.
+
+layout(std430, push_constant) uniform ScreenPushConstants {
+  vec4 background;
+  float saturation_alpha;
+  uint chunk;
+};
+
+layout(input_attachment_index = 0, binding = 0) uniform subpassInput color_image;
+
+void main() {
+  if (subpassLoad(color_image).a < saturation_alpha) discard;
+}
@@ -0,0 +1,40 @@
+#version 460 core
+
+// Fullscreen triangle at the depth of the farthest splat drawn so far. Splats are sorted near to far, so it is the last
+// splat of the chunk, and saturated pixels keep an upper bound of the depth at which they saturated.
+
+layout(std430, push_constant) uniform ScreenPushConstants {
+  vec4 background;
+  float saturation_alpha;
+  uint chunk;
+};
+
+layout(std430, binding = 1) readonly buffer Instances {
+  vec4 instances[];  // (N, 12). 3 for ndc position, 1 alpha, 4 for rot scale, 3 for color.
+};
+
+struct DrawIndexedIndirectCommand {
+  uint indexCount;
+  uint instanceCount;
+  uint firstIndex;
+  int vertexOffset;
+  uint firstInstance;
+};
+
+layout(std430, binding = 2) readonly buffer DrawIndirect {
+  DrawIndexedIndirectCommand draw_indirect[];  // (1 + CHUNK_COUNT), full draw then chunks in rank order.
+};
+
+void main() {
+  const vec2 positions[] = {
+    vec2(-1.f, -1.f),
+    vec2(-1.f, 3.f),
+    vec2(3.f, -1.f),
+  };
+
+  DrawIndexedIndirectCommand command = draw_indirect[1 + chunk];
+  uint drawn_count = (command.firstIndex + command.indexCount) / 6;
+  float depth = drawn_count > 0 ? instances[3 * (drawn_count - 1)].z : 0.f;
+
+  gl_Position = vec4(positions[gl_VertexIndex % 3], depth, 1.f);
+}
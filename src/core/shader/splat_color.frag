@@ -1,12 +1,27 @@
 #version 460 core
 
+// SPLAT_DEPTH_OUTPUTS: also blends (alpha, depth * alpha) to the second render target. Blending over back-to-front
+// weights both by front-to-back transmittance, giving accumulated alpha and the numerator of expected depth.
+
+// No depth writes, so depth tests can reject fragments of saturated pixels before shading.
+layout(early_fragment_tests) in;
+
 layout(location = 0) in vec4 color;
 layout(location = 1) in vec2 position;
+#ifdef SPLAT_DEPTH_OUTPUTS
+layout(location = 2) in float view_depth;
+#endif
 
 layout(location = 0) out vec4 out_color;  // pre-multiplied alpha: (color * alpha, alpha)
+#ifdef SPLAT_DEPTH_OUTPUTS
+layout(location = 1) out vec4 out_depth;  // pre-multiplied alpha: (alpha, depth * alpha, 0, alpha)
+#endif
 
 void main() {
   float gaussian_alpha = exp(-0.5f * dot(position, position));
   float alpha = color.a * gaussian_alpha;
   out_color = vec4(color.rgb * alpha, alpha);
+#ifdef SPLAT_DEPTH_OUTPUTS
+  out_depth = vec4(alpha, view_depth * alpha, 0.f, alpha);
+#endif
 }
@@ -1,5 +1,8 @@
 #version 460 core
 
+// SPLAT_OIT: also outputs view depth for weighted blended order-independent transparency.
+// SPLAT_DEPTH_OUTPUTS: also outputs view depth for alpha and depth render targets.
+
 layout(std430, push_constant) uniform SplatPushConstants {
   mat4 projection_inverse;
   float confidence_radius;
@@ -11,6 +14,9 @@ layout(std430, binding = 0) readonly buffer Instances {
 
 layout(location = 0) out vec4 out_color;
 layout(location = 1) out vec2 out_position;
+#if defined(SPLAT_OIT) || defined(SPLAT_DEPTH_OUTPUTS)
+layout(location = 2) out float out_view_depth;
+#endif
 
 const vec2 positions[4] = vec2[4](
   vec2(-1.f, -1.f),
@@ -36,4 +42,9 @@ void main() {
   gl_Position = vec4(ndc_position + vec3(rot_scale * position * radius, 0.f), 1.f);
   out_color = color;
   out_position = position * radius;
+
+#if defined(SPLAT_OIT) || defined(SPLAT_DEPTH_OUTPUTS)
+  vec4 view_position = projection_inverse * vec4(ndc_position, 1.f);
+  out_view_depth = -view_position.z / view_position.w;
+#endif
 }
@@ -0,0 +1,29 @@
+#version 460 core
+
+// Weighted blended order-independent transparency, accumulated with additive blending in any order.
+//
+// Revealage is the product of (1 - alpha), accumulated as a sum of -log(1 - alpha) so that both targets blend the same.
+
+layout(location = 0) in vec4 color;
+layout(location = 1) in vec2 position;
+layout(location = 2) in float view_depth;
+
+layout(location = 0) out vec4 out_accum;      // weighted pre-multiplied alpha: (color * alpha, alpha) * weight
+layout(location = 1) out float out_revealage;  // -log(1 - alpha)
+
+// Alpha values near 1 would dominate revealage.
+const float MAX_ALPHA = 0.99f;
+
+// Depth weight, from McGuire and Bavoil 2013, eq. (7). Bounded so that half float sums stay finite.
+float Weight(float z) {
+  float z5 = z / 5.f;
+  float z200 = z / 200.f;
+  return clamp(10.f / (1e-5f + z5 * z5 + z200 * z200 * z200 * z200 * z200 * z200), 1e-2f, 3e2f);
+}
+
+void main() {
+  float gaussian_alpha = exp(-0.5f * dot(position, position));
+  float alpha = min(color.a * gaussian_alpha, MAX_ALPHA);
+  out_accum = vec4(color.rgb * alpha, alpha) * Weight(view_depth);
+  out_revealage = -log(1.f - alpha);
+}
@@ -1,5 +1,7 @@
 #include "vkgs/core/details/compute_storage.h"
 
+#include "vkgs/core/screen_splats.h"
+
 #include "../struct.h"
 
 namespace vkgs {
@@ -7,24 +9,44 @@ namespace core {
 
 ComputeStorageImpl::ComputeStorageImpl() {
   camera_ = gpu::Buffer::Create(VK_BUFFER_USAGE_TRANSFER_DST_BIT | VK_BUFFER_USAGE_STORAGE_BUFFER_BIT, sizeof(Camera));
+  projection_uniforms_ = gpu::Buffer::Create(VK_BUFFER_USAGE_TRANSFER_DST_BIT | VK_BUFFER_USAGE_UNIFORM_BUFFER_BIT,
+                                             sizeof(ProjectionUniforms));
+  projection_dispatch_ = gpu::Buffer::Create(VK_BUFFER_USAGE_STORAGE_BUFFER_BIT | VK_BUFFER_USAGE_INDIRECT_BUFFER_BIT,
+                                             sizeof(VkDispatchIndirectCommand));
+
+  batch_camera_ = gpu::Buffer::Create(VK_BUFFER_USAGE_TRANSFER_DST_BIT | VK_BUFFER_USAGE_STORAGE_BUFFER_BIT,
+                                      kMaxBatchViews * sizeof(glm::mat4));
+  batch_projection_uniforms_ =
+      gpu::Buffer::Create(VK_BUFFER_USAGE_TRANSFER_DST_BIT | VK_BUFFER_USAGE_UNIFORM_BUFFER_BIT,
+                          kMaxBatchViews * sizeof(ProjectionUniforms));
+  batch_visible_point_count_ = gpu::Buffer::Create(
+      VK_BUFFER_USAGE_TRANSFER_SRC_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT | VK_BUFFER_USAGE_STORAGE_BUFFER_BIT,
+      (1 + kMaxBatchViews) * sizeof(uint32_t));
+  batch_draw_indirect_ = gpu::Buffer::Create(
+      VK_BUFFER_USAGE_TRANSFER_SRC_BIT | VK_BUFFER_USAGE_STORAGE_BUFFER_BIT,
+      kMaxBatchViews * (1 + ScreenSplatsImpl::kDrawChunkCount) * sizeof(VkDrawIndexedIndirectCommand));
 }
 
 ComputeStorageImpl::~ComputeStorageImpl() = default;
 
 void ComputeStorageImpl::Update(uint32_t point_count, VkBufferUsageFlags usage, VkDeviceSize size) {
-  // Get new stage buffers
-  camera_stage_ = gpu::Buffer::Create(VK_BUFFER_USAGE_TRANSFER_SRC_BIT, sizeof(Camera), true);
-
   if (point_count_ < point_count) {
     key_ = gpu::Buffer::Create(VK_BUFFER_USAGE_STORAGE_BUFFER_BIT, point_count * sizeof(uint32_t));
     index_ = gpu::Buffer::Create(VK_BUFFER_USAGE_STORAGE_BUFFER_BIT, point_count * sizeof(uint32_t));
     sort_storage_ = gpu::Buffer::Create(usage, size);
-    inverse_index_ = gpu::Buffer::Create(VK_BUFFER_USAGE_TRANSFER_DST_BIT | VK_BUFFER_USAGE_STORAGE_BUFFER_BIT,
-                                         point_count * sizeof(uint32_t));
+    workgroup_offset_ =
+        gpu::Buffer::Create(VK_BUFFER_USAGE_STORAGE_BUFFER_BIT, (point_count + 255) / 256 * sizeof(uint32_t));
 
     point_count_ = point_count;
   }
 }
 
+void ComputeStorageImpl::UpdateBatch(uint32_t pair_count) {
+  if (batch_pair_count_ < pair_count) {
+    batch_instances_ = gpu::Buffer::Create(VK_BUFFER_USAGE_STORAGE_BUFFER_BIT, pair_count * 12 * sizeof(float));
+    batch_pair_count_ = pair_count;
+  }
+}
+
 }  // namespace core
 }  // namespace vkgs
\ No newline at end of file
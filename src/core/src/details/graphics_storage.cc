@@ -10,15 +10,83 @@ GraphicsStorageImpl::~GraphicsStorageImpl() {}
 void GraphicsStorageImpl::Update(uint32_t width, uint32_t height) {
   if (width_ != width || height_ != height) {
     image_ = gpu::Image::Create(VK_FORMAT_R16G16B16A16_SFLOAT, width, height,
-                                VK_IMAGE_USAGE_COLOR_ATTACHMENT_BIT | VK_IMAGE_USAGE_TRANSFER_SRC_BIT);
+                                VK_IMAGE_USAGE_COLOR_ATTACHMENT_BIT | VK_IMAGE_USAGE_INPUT_ATTACHMENT_BIT |
+                                    VK_IMAGE_USAGE_STORAGE_BIT | VK_IMAGE_USAGE_TRANSFER_SRC_BIT);
     image_u8_ = gpu::Image::Create(
         VK_FORMAT_R8G8B8A8_UNORM, width, height,
         VK_IMAGE_USAGE_COLOR_ATTACHMENT_BIT | VK_IMAGE_USAGE_TRANSFER_SRC_BIT | VK_IMAGE_USAGE_TRANSFER_DST_BIT);
+    depth_ = gpu::Image::Create(VK_FORMAT_D32_SFLOAT, width, height,
+                                VK_IMAGE_USAGE_DEPTH_STENCIL_ATTACHMENT_BIT | VK_IMAGE_USAGE_TRANSFER_SRC_BIT);
+    oit_accum_ = gpu::Image::Create(VK_FORMAT_R16G16B16A16_SFLOAT, width, height,
+                                    VK_IMAGE_USAGE_COLOR_ATTACHMENT_BIT | VK_IMAGE_USAGE_INPUT_ATTACHMENT_BIT);
+    oit_revealage_ = gpu::Image::Create(VK_FORMAT_R16_SFLOAT, width, height,
+                                        VK_IMAGE_USAGE_COLOR_ATTACHMENT_BIT | VK_IMAGE_USAGE_INPUT_ATTACHMENT_BIT);
+    depth_outputs_.reset();
+    cube_faces_.reset();
+
+    hiz_depth_ = gpu::Buffer::Create(VK_BUFFER_USAGE_TRANSFER_DST_BIT | VK_BUFFER_USAGE_STORAGE_BUFFER_BIT,
+                                     width * height * sizeof(float));
+    uint32_t hiz_size = 0;
+    hiz_level_count_ = 0;
+    for (uint32_t w = (width + 1) / 2, h = (height + 1) / 2;; w = (w + 1) / 2, h = (h + 1) / 2) {
+      hiz_size += w * h;
+      hiz_level_count_++;
+      if (w == 1 && h == 1) break;
+    }
+    hiz_ = gpu::Buffer::Create(VK_BUFFER_USAGE_STORAGE_BUFFER_BIT, hiz_size * 2 * sizeof(float));
+    hiz_valid_ = false;
+
+    uint32_t tile_count = ((width + kTileSize - 1) / kTileSize) * ((height + kTileSize - 1) / kTileSize);
+    tile_ranges_ = gpu::Buffer::Create(VK_BUFFER_USAGE_TRANSFER_DST_BIT | VK_BUFFER_USAGE_STORAGE_BUFFER_BIT,
+                                       tile_count * 2 * sizeof(uint32_t));
 
     width_ = width;
     height_ = height;
   }
 }
 
+void GraphicsStorageImpl::UpdateDepthOutputs() {
+  if (!depth_outputs_) {
+    depth_outputs_ = gpu::Image::Create(
+        VK_FORMAT_R32G32B32A32_SFLOAT, width_, height_,
+        VK_IMAGE_USAGE_COLOR_ATTACHMENT_BIT | VK_IMAGE_USAGE_STORAGE_BIT | VK_IMAGE_USAGE_TRANSFER_SRC_BIT);
+  }
+}
+
+void GraphicsStorageImpl::UpdateCubemap(uint32_t equirect_width, uint32_t equirect_height) {
+  if (!cube_faces_) {
+    cube_faces_ =
+        gpu::Buffer::Create(VK_BUFFER_USAGE_STORAGE_BUFFER_BIT, 6 * width_ * height_ * 4 * sizeof(uint16_t));
+  }
+
+  if (!equirect_ || equirect_->width() != equirect_width || equirect_->height() != equirect_height) {
+    equirect_ = gpu::Image::Create(VK_FORMAT_R16G16B16A16_SFLOAT, equirect_width, equirect_height,
+                                   VK_IMAGE_USAGE_STORAGE_BIT);
+  }
+}
+
+void GraphicsStorageImpl::UpdateTiles(uint32_t point_count, uint32_t tile_capacity, VkBufferUsageFlags usage,
+                                      VkDeviceSize size) {
+  if (!tile_splat_count_) {
+    tile_splat_count_ =
+        gpu::Buffer::Create(VK_BUFFER_USAGE_STORAGE_BUFFER_BIT | VK_BUFFER_USAGE_TRANSFER_SRC_BIT, 2 * sizeof(uint32_t));
+    tile_dispatch_ = gpu::Buffer::Create(VK_BUFFER_USAGE_STORAGE_BUFFER_BIT | VK_BUFFER_USAGE_INDIRECT_BUFFER_BIT,
+                                         sizeof(VkDispatchIndirectCommand));
+  }
+
+  if (point_count_ < point_count) {
+    tile_workgroup_offset_ =
+        gpu::Buffer::Create(VK_BUFFER_USAGE_STORAGE_BUFFER_BIT, (point_count + 255) / 256 * sizeof(uint32_t));
+    point_count_ = point_count;
+  }
+
+  if (tile_capacity_ < tile_capacity) {
+    tile_keys_ = gpu::Buffer::Create(VK_BUFFER_USAGE_STORAGE_BUFFER_BIT, tile_capacity * sizeof(uint32_t));
+    tile_values_ = gpu::Buffer::Create(VK_BUFFER_USAGE_STORAGE_BUFFER_BIT, tile_capacity * sizeof(uint32_t));
+    tile_sort_storage_ = gpu::Buffer::Create(usage, size);
+    tile_capacity_ = tile_capacity;
+  }
+}
+
 }  // namespace core
 }  // namespace vkgs
@@ -1,26 +1,160 @@
 #include "vkgs/core/details/sorter.h"
 
+#include "vkgs/gpu/cmd/barrier.h"
+#include "vkgs/gpu/cmd/pipeline.h"
+
+#include "generated/sort_bitonic.h"
+#include "generated/sort_split.h"
+
 namespace vkgs {
 namespace core {
 
-SorterImpl::SorterImpl(VkDevice device, VkPhysicalDevice physical_device) {
+SorterImpl::SorterImpl() = default;
+
+SorterImpl::~SorterImpl() = default;
+
+RadixSorterImpl::RadixSorterImpl(VkDevice device, VkPhysicalDevice physical_device) {
   VrdxSorterCreateInfo sorter_info = {};
   sorter_info.physicalDevice = physical_device;
   sorter_info.device = device;
   vrdxCreateSorter(&sorter_info, &sorter_);
 }
 
-SorterImpl::~SorterImpl() { vrdxDestroySorter(sorter_); }
+RadixSorterImpl::~RadixSorterImpl() { vrdxDestroySorter(sorter_); }
 
-VrdxSorterStorageRequirements SorterImpl::GetStorageRequirements(size_t max_size) const {
+SorterStorageRequirements RadixSorterImpl::GetStorageRequirements(size_t max_size) const {
   VrdxSorterStorageRequirements requirements;
   vrdxGetSorterKeyValueStorageRequirements(sorter_, max_size, &requirements);
-  return requirements;
+  return {requirements.size, requirements.usage};
+}
+
+void RadixSorterImpl::SortKeyValueIndirect(VkCommandBuffer cb, size_t max_size, VkBuffer size, VkBuffer key,
+                                           VkBuffer value, VkBuffer storage) const {
+  SortKeyValueIndirect(cb, max_size, size, 0, key, value, storage, 0);
+}
+
+void RadixSorterImpl::SortKeyValueIndirect(VkCommandBuffer cb, size_t max_size, VkBuffer size,
+                                           VkDeviceSize size_offset, VkBuffer key, VkBuffer value, VkBuffer storage,
+                                           VkDeviceSize storage_offset) const {
+  vrdxCmdSortKeyValueIndirect(cb, sorter_, max_size, size, size_offset, key, 0, value, 0, storage, storage_offset,
+                              VK_NULL_HANDLE, 0);
+}
+
+BitonicSorterImpl::BitonicSorterImpl(VkDevice device, VkPhysicalDevice physical_device) {
+  VkPhysicalDeviceProperties properties;
+  vkGetPhysicalDeviceProperties(physical_device, &properties);
+
+  // Keys and input positions in shared memory.
+  available_ = properties.limits.maxComputeSharedMemorySize >= kCapacity * 2 * sizeof(uint32_t);
+  if (!available_) return;
+
+  pipeline_layout_ = gpu::PipelineLayout::Create({
+      .bindings =
+          {
+              {0, VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, 1, VK_SHADER_STAGE_COMPUTE_BIT},
+              {1, VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, 1, VK_SHADER_STAGE_COMPUTE_BIT},
+              {2, VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, 1, VK_SHADER_STAGE_COMPUTE_BIT},
+          },
+  });
+  pipeline_ = gpu::ComputePipeline::Create(pipeline_layout_, sort_bitonic);
+}
+
+BitonicSorterImpl::~BitonicSorterImpl() = default;
+
+SorterStorageRequirements BitonicSorterImpl::GetStorageRequirements(size_t max_size) const {
+  // No scratch storage, but keep a valid buffer size.
+  return {sizeof(uint32_t), VK_BUFFER_USAGE_STORAGE_BUFFER_BIT};
+}
+
+void BitonicSorterImpl::SortKeyValueIndirect(VkCommandBuffer cb, size_t max_size, VkBuffer size, VkBuffer key,
+                                             VkBuffer value, VkBuffer storage) const {
+  gpu::cmd::Pipeline(VK_PIPELINE_BIND_POINT_COMPUTE, pipeline_layout_)
+      .Storage(0, size)
+      .Storage(1, key)
+      .Storage(2, value)
+      .Bind(pipeline_)
+      .Commit(cb);
+  vkCmdDispatch(cb, 1, 1, 1);
+}
+
+AutoSorterImpl::AutoSorterImpl(VkDevice device, VkPhysicalDevice physical_device)
+    : radix_(std::make_shared<RadixSorterImpl>(device, physical_device)),
+      bitonic_(std::make_shared<BitonicSorterImpl>(device, physical_device)) {
+  if (!bitonic_->available()) return;
+
+  split_pipeline_layout_ = gpu::PipelineLayout::Create({
+      .bindings =
+          {
+              {0, VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, 1, VK_SHADER_STAGE_COMPUTE_BIT},
+              {1, VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, 1, VK_SHADER_STAGE_COMPUTE_BIT},
+          },
+  });
+  split_pipeline_ = gpu::ComputePipeline::Create(split_pipeline_layout_, sort_split);
+}
+
+AutoSorterImpl::~AutoSorterImpl() = default;
+
+const SorterImpl* AutoSorterImpl::Select(size_t max_size) const {
+  if (bitonic_->Supports(max_size)) return bitonic_.get();
+  return radix_.get();
+}
+
+bool AutoSorterImpl::SelectsOnDevice(size_t max_size) const {
+  return bitonic_->available() && !bitonic_->Supports(max_size);
+}
+
+SorterStorageRequirements AutoSorterImpl::GetStorageRequirements(size_t max_size) const {
+  if (!SelectsOnDevice(max_size)) return Select(max_size)->GetStorageRequirements(max_size);
+
+  auto requirements = radix_->GetStorageRequirements(max_size);
+  return {kRadixStorageOffset + requirements.size, requirements.usage | VK_BUFFER_USAGE_STORAGE_BUFFER_BIT};
+}
+
+void AutoSorterImpl::SortKeyValueIndirect(VkCommandBuffer cb, size_t max_size, VkBuffer size, VkBuffer key,
+                                          VkBuffer value, VkBuffer storage) const {
+  if (!SelectsOnDevice(max_size)) {
+    Select(max_size)->SortKeyValueIndirect(cb, max_size, size, key, value, storage);
+    return;
+  }
+
+  // Visible counts of large scenes are often small, e.g. views of a corner. Split the count on GPU instead of sorting
+  // by the capacity.
+  gpu::cmd::Pipeline(VK_PIPELINE_BIND_POINT_COMPUTE, split_pipeline_layout_)
+      .Storage(0, size)
+      .Storage(1, storage)
+      .Bind(split_pipeline_)
+      .Commit(cb);
+  vkCmdDispatch(cb, 1, 1, 1);
+
+  gpu::cmd::Barrier()
+      .Memory(VK_PIPELINE_STAGE_2_COMPUTE_SHADER_BIT, VK_ACCESS_2_SHADER_WRITE_BIT,
+              VK_PIPELINE_STAGE_2_COMPUTE_SHADER_BIT | VK_PIPELINE_STAGE_2_TRANSFER_BIT,
+              VK_ACCESS_2_SHADER_READ_BIT | VK_ACCESS_2_TRANSFER_READ_BIT)
+      .Commit(cb);
+
+  // Bitonic reads its count from the start of storage.
+  bitonic_->SortKeyValueIndirect(cb, BitonicSorterImpl::kCapacity, storage, key, value, storage);
+
+  gpu::cmd::Barrier()
+      .Memory(VK_PIPELINE_STAGE_2_COMPUTE_SHADER_BIT, VK_ACCESS_2_SHADER_WRITE_BIT,
+              VK_PIPELINE_STAGE_2_COMPUTE_SHADER_BIT | VK_PIPELINE_STAGE_2_TRANSFER_BIT,
+              VK_ACCESS_2_SHADER_READ_BIT | VK_ACCESS_2_SHADER_WRITE_BIT | VK_ACCESS_2_TRANSFER_READ_BIT |
+                  VK_ACCESS_2_TRANSFER_WRITE_BIT)
+      .Commit(cb);
+
+  radix_->SortKeyValueIndirect(cb, max_size, storage, kRadixCountOffset, key, value, storage, kRadixStorageOffset);
 }
 
-void SorterImpl::SortKeyValueIndirect(VkCommandBuffer cb, size_t max_size, VkBuffer size, VkBuffer key, VkBuffer value,
-                                      VkBuffer storage) const {
-  vrdxCmdSortKeyValueIndirect(cb, sorter_, max_size, size, 0, key, 0, value, 0, storage, 0, VK_NULL_HANDLE, 0);
+Sorter Sorter::Create(SorterType type, VkDevice device, VkPhysicalDevice physical_device) {
+  switch (type) {
+    case SorterType::RADIX:
+      return FromPtr(std::make_shared<RadixSorterImpl>(device, physical_device));
+    case SorterType::BITONIC:
+      return FromPtr(std::make_shared<BitonicSorterImpl>(device, physical_device));
+    case SorterType::AUTO:
+    default:
+      return FromPtr(std::make_shared<AutoSorterImpl>(device, physical_device));
+  }
 }
 
 }  // namespace core
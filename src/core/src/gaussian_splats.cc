@@ -25,5 +25,9 @@ void GaussianSplatsImpl::Wait() {
   }
 }
 
+void GaussianSplatsImpl::WaitFence() {
+  if (task_) task_->WaitFence();
+}
+
 }  // namespace core
 }  // namespace vkgs
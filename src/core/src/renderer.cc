@@ -1,6 +1,15 @@
 #include "vkgs/core/renderer.h"
 
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
 #include <cstring>
+#include <stdexcept>
+#include <string>
+#include <utility>
 
 #include <glm/glm.hpp>
 #include <glm/gtc/matrix_transform.hpp>
@@ -20,33 +29,267 @@
 #include "vkgs/core/gaussian_splats.h"
 #include "vkgs/core/rendering_task.h"
 #include "vkgs/core/screen_splats.h"
+#include "vkgs/core/stats.h"
+#include "generated/background_frag.h"
+#include "generated/convert_output.h"
+#include "generated/depth_resolve.h"
+#include "generated/equirect.h"
+#include "generated/hiz.h"
 #include "generated/rank.h"
-#include "generated/inverse_index.h"
+#include "generated/rank_count.h"
+#include "generated/rank_scan.h"
+#include "generated/rank_deterministic.h"
+#include "generated/rank_occlusion.h"
+#include "generated/rank_count_occlusion.h"
+#include "generated/rank_deterministic_occlusion.h"
+#include "generated/rank_stereo.h"
+#include "generated/rank_count_stereo.h"
+#include "generated/rank_deterministic_stereo.h"
+#include "generated/rank_batch.h"
+#include "generated/indirect.h"
+#include "generated/indirect_batch.h"
+#include "generated/oit_resolve_frag.h"
 #include "generated/projection.h"
+#include "generated/projection_batch.h"
+#include "generated/saturate_frag.h"
+#include "generated/saturate_vert.h"
+#include "generated/screen_vert.h"
 #include "generated/splat_color_vert.h"
 #include "generated/splat_color_frag.h"
 #include "generated/splat_depth_vert.h"
 #include "generated/splat_depth_frag.h"
+#include "generated/splat_depth_outputs_vert.h"
+#include "generated/splat_depth_outputs_frag.h"
+#include "generated/splat_oit_vert.h"
+#include "generated/splat_oit_frag.h"
+#include "generated/tile_count.h"
+#include "generated/tile_emit.h"
+#include "generated/tile_scan.h"
+#include "generated/tile_range.h"
+#include "generated/tile_raster.h"
+#include "generated/tile_raster_depth_outputs.h"
 #include "struct.h"
 
 namespace {
 
 auto WorkgroupSize(size_t count, uint32_t local_size) { return (count + local_size - 1) / local_size; }
 
+// Tile-splat pair capacity per point, unless earlier draws requested more. Pairs over capacity are dropped, and
+// reported in the draw result.
+constexpr uint32_t kTilePairsPerPoint = 8;
+
+// Upper bound of tile-splat pair capacity, 512 MiB each of keys and values, within the 32-bit sort size.
+constexpr uint64_t kMaxTilePairCapacity = 1ull << 27;
+
+// Tile pair counts (stored, requested) for the draw result.
+vkgs::gpu::Buffer CreateTilePairCount(const vkgs::core::DrawOptions& draw_options) {
+  if (draw_options.rasterizer != vkgs::core::Rasterizer::TILE) return {};
+  return vkgs::gpu::Buffer::Create(VK_BUFFER_USAGE_TRANSFER_DST_BIT, 2 * sizeof(uint32_t), true);
+}
+
+// Pairs dropped by a done rasterization, from its tile pair counts. Raises the demand for later draws to the
+// requested count, with headroom.
+uint32_t DroppedTilePairCount(vkgs::gpu::Buffer tile_pair_count, std::atomic<uint64_t>& demand) {
+  if (!tile_pair_count) return 0;
+  const auto* counts = tile_pair_count->data<uint32_t>();
+  if (counts[1] <= counts[0]) return 0;
+
+  uint64_t requested = counts[1] + counts[1] / 4ull;
+  uint64_t previous = demand.load();
+  while (previous < requested && !demand.compare_exchange_weak(previous, requested)) {
+  }
+  return counts[1] - counts[0];
+}
+
+// Front-to-back alpha above which a pixel is saturated. Later splats change 8-bit output by less than one level.
+constexpr float kSaturationAlpha = 1.f - 1.f / 255.f;
+
+// Specialization value of projection degrees for branching at runtime, DYNAMIC_DEGREE in projection.comp.
+constexpr int kDynamicDegree = -2;
+
+// Depth pyramid for the next frame in the ring slot is only built by front-to-back rendering.
+bool BuildsHiz(const vkgs::core::DrawOptions& draw_options) {
+  return draw_options.occlusion_culling && draw_options.front_to_back &&
+         draw_options.rasterizer == vkgs::core::Rasterizer::HARDWARE;
+}
+
+// Outputs other than plain RGBA8 are converted by a compute pass instead of blitted to the uint8 image and copied.
+bool ConvertsOutput(const vkgs::core::DrawOptions& draw_options) {
+  return draw_options.output_format != vkgs::core::OutputFormat::RGBA8 || draw_options.output_planar ||
+         draw_options.output_srgb;
+}
+
+// Depth outputs are blended back-to-front by hardware, or front-to-back per pixel by the tile rasterizer.
+bool SupportsDepthOutputs(const vkgs::core::DrawOptions& draw_options) {
+  return draw_options.rasterizer == vkgs::core::Rasterizer::TILE ||
+         (draw_options.rasterizer == vkgs::core::Rasterizer::HARDWARE && !draw_options.front_to_back);
+}
+
+// Views sharing one rank, sort and projection in ComputeScreenSplatsBatch. Draws reading instances without the first
+// instance of a view, and per-view stats, color cache and deterministic ranks are computed per view instead.
+bool SupportsBatchedCompute(const std::vector<vkgs::core::DrawOptions>& draw_options) {
+  for (const auto& options : draw_options) {
+    if (options.rasterizer != vkgs::core::Rasterizer::HARDWARE || options.front_to_back || options.deterministic ||
+        options.record_stat || options.color_cache_angle > 0.f || options.sh_degree != draw_options[0].sh_degree ||
+        options.generic_projection != draw_options[0].generic_projection) {
+      return false;
+    }
+  }
+  return true;
+}
+
+// Bytes of one depth outputs image, (H, W, 4) float32.
+size_t DepthOutputSize(const vkgs::core::DrawOptions& draw_options) {
+  return static_cast<size_t>(draw_options.width) * draw_options.height * 4 * sizeof(float);
+}
+
+// Uniforms of the projection pass for the camera of draw options.
+vkgs::core::ProjectionUniforms GetProjectionUniforms(const vkgs::core::DrawOptions& draw_options) {
+  glm::uvec2 screen_size(draw_options.width, draw_options.height);
+  glm::vec4 camera_model_position = glm::inverse(draw_options.model) * glm::inverse(draw_options.view)[3];
+  return {
+      .model_view = draw_options.view * draw_options.model,
+      .projection = draw_options.projection,
+      .camera_model_position = camera_model_position / camera_model_position.w,
+      .low_pass = draw_options.eps2d * 4.f / glm::vec2(screen_size * screen_size),
+      // Degree = 3-sigma pixel radius / sh_lod_radius, with NDC standard deviation s0 spanning s0 / 2 * size pixels.
+      .sh_lod_scale = draw_options.sh_lod_radius > 0.f
+                          ? 1.5f * std::max(draw_options.width, draw_options.height) / draw_options.sh_lod_radius
+                          : 0.f,
+      .color_cache_cos = std::cos(glm::radians(draw_options.color_cache_angle)),
+  };
+}
+
+// View matrix of the camera at the midpoint of two eyes, with the orientation of the first.
+glm::mat4 MidpointView(const glm::mat4& view0, const glm::mat4& view1) {
+  glm::vec3 center = 0.5f * (glm::vec3(glm::inverse(view0)[3]) + glm::vec3(glm::inverse(view1)[3]));
+  glm::mat4 view = view0;
+  view[3] = glm::vec4(-glm::mat3(view0) * center, 1.f);
+  return view;
+}
+
+// Cube face (forward, up) in camera space, in +X, -X, +Y, -Y, +Z, -Z order. Must match FACE_FORWARD and FACE_UP in
+// equirect.comp.
+const std::array<std::pair<glm::vec3, glm::vec3>, 6> kCubeFaces = {{
+    {{1.f, 0.f, 0.f}, {0.f, 1.f, 0.f}},
+    {{-1.f, 0.f, 0.f}, {0.f, 1.f, 0.f}},
+    {{0.f, 1.f, 0.f}, {0.f, 0.f, 1.f}},
+    {{0.f, -1.f, 0.f}, {0.f, 0.f, -1.f}},
+    {{0.f, 0.f, 1.f}, {0.f, 1.f, 0.f}},
+    {{0.f, 0.f, -1.f}, {0.f, 1.f, 0.f}},
+}};
+
+// Draw options of a 90 degree cube face, keeping near, far and axis signs of the projection.
+vkgs::core::DrawOptions CubeFaceOptions(const vkgs::core::DrawOptions& draw_options, size_t face) {
+  auto options = draw_options;
+  const auto& [forward, up] = kCubeFaces[face];
+  options.view = glm::lookAtRH(glm::vec3(0.f), forward, up) * draw_options.view;
+  options.projection[0][0] = draw_options.projection[0][0] < 0.f ? -1.f : 1.f;
+  options.projection[1][1] = draw_options.projection[1][1] < 0.f ? -1.f : 1.f;
+  options.projection[2][0] = 0.f;
+  options.projection[2][1] = 0.f;
+  options.occlusion_culling = false;
+  return options;
+}
+
+// Channels of one output pixel.
+uint32_t OutputChannelCount(const vkgs::core::DrawOptions& draw_options) {
+  switch (draw_options.output_format) {
+    case vkgs::core::OutputFormat::RGB8:
+    case vkgs::core::OutputFormat::RGB32F:
+      return 3;
+    default:
+      return 4;
+  }
+}
+
+// Bytes of one output channel.
+uint32_t OutputElementSize(const vkgs::core::DrawOptions& draw_options) {
+  switch (draw_options.output_format) {
+    case vkgs::core::OutputFormat::RGBA16F:
+      return 2;
+    case vkgs::core::OutputFormat::RGB32F:
+      return 4;
+    default:
+      return 1;
+  }
+}
+
+// Bytes of one output image.
+size_t OutputSize(const vkgs::core::DrawOptions& draw_options) {
+  size_t pixel_count = static_cast<size_t>(draw_options.width) * draw_options.height;
+  return pixel_count * OutputChannelCount(draw_options) * OutputElementSize(draw_options);
+}
+
+// Draw options of the region [offset, offset + size) of the image of draw options, as an image of that size. The
+// projection is cropped in NDC, so the rank pass culls splats outside the frustum of the region.
+vkgs::core::DrawOptions CropOptions(const vkgs::core::DrawOptions& draw_options, glm::uvec2 offset, glm::uvec2 size) {
+  glm::vec2 image_size(draw_options.width, draw_options.height);
+  glm::vec2 scale = image_size / glm::vec2(size);
+  glm::vec2 center = (glm::vec2(offset) + 0.5f * glm::vec2(size)) / image_size * 2.f - 1.f;
+
+  glm::mat4 crop(1.f);
+  crop[0][0] = scale.x;
+  crop[1][1] = scale.y;
+  crop[3][0] = -scale.x * center.x;
+  crop[3][1] = -scale.y * center.y;
+
+  auto options = draw_options;
+  options.projection = crop * draw_options.projection;
+  options.width = size.x;
+  options.height = size.y;
+  options.roi = glm::uvec4(0);
+  return options;
+}
+
+// Draw options of the region of interest of draw options, or draw options if the whole image is drawn.
+vkgs::core::DrawOptions RoiOptions(const vkgs::core::DrawOptions& draw_options) {
+  const auto& roi = draw_options.roi;
+  if (roi.z == 0 || roi.w == 0) return draw_options;
+  if (roi.x + roi.z > draw_options.width || roi.y + roi.w > draw_options.height) {
+    throw std::runtime_error("Region of interest must be inside the image");
+  }
+  return CropOptions(draw_options, {roi.x, roi.y}, {roi.z, roi.w});
+}
+
+// Copies a tile image of (planes, tile_size, tile_size) texels, holding the region at its origin, into the region of
+// the (planes, height, width) image.
+void CopyTile(const uint8_t* tile, uint8_t* image, uint32_t width, uint32_t height, uint32_t tile_size,
+              glm::uvec4 region, uint32_t plane_count, size_t texel_size) {
+  for (uint32_t plane = 0; plane < plane_count; ++plane) {
+    const uint8_t* src = tile + plane * tile_size * tile_size * texel_size;
+    uint8_t* dst = image + (plane * static_cast<size_t>(height) * width) * texel_size;
+    for (uint32_t row = 0; row < region.w; ++row) {
+      std::memcpy(dst + ((region.y + row) * static_cast<size_t>(width) + region.x) * texel_size,
+                  src + row * tile_size * texel_size, region.z * texel_size);
+    }
+  }
+}
+
 }  // namespace
 
 namespace vkgs {
 namespace core {
 
-RendererImpl::RendererImpl() {
+RendererImpl::RendererImpl(uint32_t ring_size) {
+  if (ring_size < kMinRingSize || ring_size > kMaxRingSize) {
+    throw std::runtime_error("Ring size must be in [" + std::to_string(kMinRingSize) + ", " +
+                             std::to_string(kMaxRingSize) + "], got " + std::to_string(ring_size));
+  }
+
   auto device = gpu::GetDevice();
-  sorter_ = Sorter::Create(device, device->physical_device());
+  sorter_ = Sorter::Create(SorterType::AUTO, device, device->physical_device());
+  // Tile binning relies on stable sort to keep depth order within a tile.
+  tile_sorter_ = Sorter::Create(SorterType::RADIX, device, device->physical_device());
 
   device_name_ = device->device_name();
   graphics_queue_index_ = device->graphics_queue_index();
   compute_queue_index_ = device->compute_queue_index();
   transfer_queue_index_ = device->transfer_queue_index();
+  pipeline_statistics_query_ = device->pipeline_statistics_query();
+  max_image_size_ = device->max_image_size();
 
+  ring_buffer_.resize(ring_size);
   for (auto& buffer : ring_buffer_) {
     buffer.compute_storage = ComputeStorage::Create();
     buffer.screen_splats = ScreenSplats::Create();
@@ -56,6 +299,16 @@ RendererImpl::RendererImpl() {
     buffer.transfer_semaphore = device->AllocateSemaphore();
   }
 
+  batch_buffer_.resize(ring_size);
+  for (auto& buffer : batch_buffer_) {
+    buffer.compute_storage = ComputeStorage::Create();
+    buffer.screen_splats.resize(kBatchChunkSize);
+    for (auto& screen_splats : buffer.screen_splats) screen_splats = ScreenSplats::Create();
+    buffer.graphics_storage = GraphicsStorage::Create();
+    buffer.compute_semaphore = device->AllocateSemaphore();
+    buffer.graphics_semaphore = device->AllocateSemaphore();
+  }
+
   compute_pipeline_layout_ = gpu::PipelineLayout::Create({
       .bindings =
           {
@@ -69,23 +322,103 @@ RendererImpl::RendererImpl() {
               {7, VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, 1, VK_SHADER_STAGE_COMPUTE_BIT},
               {8, VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, 1, VK_SHADER_STAGE_COMPUTE_BIT},
               {9, VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, 1, VK_SHADER_STAGE_COMPUTE_BIT},
+              {10, VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER, 1, VK_SHADER_STAGE_COMPUTE_BIT},
+              {11, VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, 1, VK_SHADER_STAGE_COMPUTE_BIT},
           },
       .push_constants = {{VK_SHADER_STAGE_COMPUTE_BIT, 0, sizeof(ProjectionPushConstants)}},
   });
   rank_pipeline_ = gpu::ComputePipeline::Create(compute_pipeline_layout_, rank);
-  inverse_index_pipeline_ = gpu::ComputePipeline::Create(compute_pipeline_layout_, inverse_index);
-  projection_pipeline_ = gpu::ComputePipeline::Create(compute_pipeline_layout_, projection);
+  rank_count_pipeline_ = gpu::ComputePipeline::Create(compute_pipeline_layout_, rank_count);
+  rank_scan_pipeline_ = gpu::ComputePipeline::Create(compute_pipeline_layout_, rank_scan);
+  rank_deterministic_pipeline_ = gpu::ComputePipeline::Create(compute_pipeline_layout_, rank_deterministic);
+  rank_occlusion_pipeline_ = gpu::ComputePipeline::Create(compute_pipeline_layout_, rank_occlusion);
+  rank_count_occlusion_pipeline_ = gpu::ComputePipeline::Create(compute_pipeline_layout_, rank_count_occlusion);
+  rank_deterministic_occlusion_pipeline_ =
+      gpu::ComputePipeline::Create(compute_pipeline_layout_, rank_deterministic_occlusion);
+  rank_stereo_pipeline_ = gpu::ComputePipeline::Create(compute_pipeline_layout_, rank_stereo);
+  rank_count_stereo_pipeline_ = gpu::ComputePipeline::Create(compute_pipeline_layout_, rank_count_stereo);
+  rank_deterministic_stereo_pipeline_ =
+      gpu::ComputePipeline::Create(compute_pipeline_layout_, rank_deterministic_stereo);
+  rank_batch_pipeline_ = gpu::ComputePipeline::Create(compute_pipeline_layout_, rank_batch);
+  indirect_pipeline_ = gpu::ComputePipeline::Create(compute_pipeline_layout_, indirect);
+  indirect_batch_pipeline_ = gpu::ComputePipeline::Create(compute_pipeline_layout_, indirect_batch);
 
   graphics_pipeline_layout_ = gpu::PipelineLayout::Create({
       .bindings = {{0, VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, 1, VK_SHADER_STAGE_VERTEX_BIT}},
       .push_constants = {{VK_SHADER_STAGE_VERTEX_BIT, 0, sizeof(SplatPushConstants)}},
   });
+
+  screen_pipeline_layout_ = gpu::PipelineLayout::Create({
+      .bindings =
+          {
+              {0, VK_DESCRIPTOR_TYPE_INPUT_ATTACHMENT, 1, VK_SHADER_STAGE_FRAGMENT_BIT},
+              {1, VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, 1, VK_SHADER_STAGE_VERTEX_BIT},
+              {2, VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, 1, VK_SHADER_STAGE_VERTEX_BIT},
+              {3, VK_DESCRIPTOR_TYPE_INPUT_ATTACHMENT, 1, VK_SHADER_STAGE_FRAGMENT_BIT},
+          },
+      .push_constants = {{VK_SHADER_STAGE_VERTEX_BIT | VK_SHADER_STAGE_FRAGMENT_BIT, 0, sizeof(ScreenPushConstants)}},
+  });
+
+  output_pipeline_layout_ = gpu::PipelineLayout::Create({
+      .bindings =
+          {
+              {0, VK_DESCRIPTOR_TYPE_STORAGE_IMAGE, 1, VK_SHADER_STAGE_COMPUTE_BIT},
+              {1, VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, 1, VK_SHADER_STAGE_COMPUTE_BIT},
+          },
+      .push_constants = {{VK_SHADER_STAGE_COMPUTE_BIT, 0, sizeof(OutputPushConstants)}},
+  });
+  output_pipeline_ = gpu::ComputePipeline::Create(output_pipeline_layout_, convert_output);
+  depth_resolve_pipeline_ = gpu::ComputePipeline::Create(output_pipeline_layout_, depth_resolve);
+  equirect_pipeline_ = gpu::ComputePipeline::Create(output_pipeline_layout_, equirect);
+
+  hiz_pipeline_layout_ = gpu::PipelineLayout::Create({
+      .bindings =
+          {
+              {0, VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, 1, VK_SHADER_STAGE_COMPUTE_BIT},
+              {1, VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, 1, VK_SHADER_STAGE_COMPUTE_BIT},
+          },
+      .push_constants = {{VK_SHADER_STAGE_COMPUTE_BIT, 0, sizeof(HizPushConstants)}},
+  });
+  hiz_pipeline_ = gpu::ComputePipeline::Create(hiz_pipeline_layout_, hiz);
+
+  tile_pipeline_layout_ = gpu::PipelineLayout::Create({
+      .bindings =
+          {
+              {0, VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, 1, VK_SHADER_STAGE_COMPUTE_BIT},
+              {1, VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, 1, VK_SHADER_STAGE_COMPUTE_BIT},
+              {2, VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, 1, VK_SHADER_STAGE_COMPUTE_BIT},
+              {3, VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, 1, VK_SHADER_STAGE_COMPUTE_BIT},
+              {4, VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, 1, VK_SHADER_STAGE_COMPUTE_BIT},
+              {5, VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, 1, VK_SHADER_STAGE_COMPUTE_BIT},
+              {6, VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, 1, VK_SHADER_STAGE_COMPUTE_BIT},
+              {7, VK_DESCRIPTOR_TYPE_STORAGE_IMAGE, 1, VK_SHADER_STAGE_COMPUTE_BIT},
+              {8, VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, 1, VK_SHADER_STAGE_COMPUTE_BIT},
+              {9, VK_DESCRIPTOR_TYPE_STORAGE_IMAGE, 1, VK_SHADER_STAGE_COMPUTE_BIT},
+          },
+      .push_constants = {{VK_SHADER_STAGE_COMPUTE_BIT, 0, sizeof(TilePushConstants)}},
+  });
+  tile_count_pipeline_ = gpu::ComputePipeline::Create(tile_pipeline_layout_, tile_count);
+  tile_scan_pipeline_ = gpu::ComputePipeline::Create(tile_pipeline_layout_, tile_scan);
+  tile_emit_pipeline_ = gpu::ComputePipeline::Create(tile_pipeline_layout_, tile_emit);
+  tile_range_pipeline_ = gpu::ComputePipeline::Create(tile_pipeline_layout_, tile_range);
+  tile_raster_pipeline_ = gpu::ComputePipeline::Create(tile_pipeline_layout_, tile_raster);
+  tile_raster_depth_outputs_pipeline_ = gpu::ComputePipeline::Create(tile_pipeline_layout_, tile_raster_depth_outputs);
 }
 
 RendererImpl::~RendererImpl() = default;
 
-RenderingTask RendererImpl::Draw(GaussianSplats splats, const DrawOptions& draw_options,
-                                 const ScreenSplatOptions& screen_splat_options, uint8_t* dst) {
+RenderingTask RendererImpl::Draw(GaussianSplats splats, const DrawOptions& image_options,
+                                 const ScreenSplatOptions& screen_splat_options, uint8_t* dst, float* depth_dst) {
+  // Targets are allocated at the size of the region of interest only.
+  auto draw_options = RoiOptions(image_options);
+  if (draw_options.output_depth && !SupportsDepthOutputs(draw_options)) {
+    throw std::runtime_error("Draw: depth outputs are not supported with front_to_back or OIT");
+  }
+  if (draw_options.width > max_image_size_ || draw_options.height > max_image_size_) {
+    throw std::runtime_error("Draw: size exceeds the device limit of " + std::to_string(max_image_size_) +
+                             ", use DrawTiled");
+  }
+
   auto rendering_task = RenderingTask::Create();
 
   uint32_t width = draw_options.width;
@@ -93,8 +426,8 @@ RenderingTask RendererImpl::Draw(GaussianSplats splats, const DrawOptions& draw_
 
   auto N = splats->size();
 
-  // Update storages
-  const auto& ring_buffer = ring_buffer_[frame_index_ % ring_buffer_.size()];
+  // Update storages. Semaphores belong to the ring slot, so the previous values are of frame i-R for ring size R.
+  auto& ring_buffer = ring_buffer_[frame_index_ % ring_buffer_.size()];
   auto compute_storage = ring_buffer.compute_storage;
   auto screen_splats = ring_buffer.screen_splats;
   auto graphics_storage = ring_buffer.graphics_storage;
@@ -114,6 +447,24 @@ RenderingTask RendererImpl::Draw(GaussianSplats splats, const DrawOptions& draw_
 
   auto timer = gpu::Timer::Create(3);
 
+  // Splat fragment shader invocations, i.e. overdraw.
+  gpu::PipelineStatistics fragment_statistics;
+  if (pipeline_statistics_query_ && draw_options.rasterizer != Rasterizer::TILE) {
+    fragment_statistics = gpu::PipelineStatistics::Create(VK_QUERY_PIPELINE_STATISTIC_FRAGMENT_SHADER_INVOCATIONS_BIT,
+                                                          ScreenSplatsImpl::kDrawChunkCount);
+  }
+
+  bool build_hiz = BuildsHiz(draw_options);
+  bool convert_output = ConvertsOutput(draw_options);
+
+  auto tile_pair_count = CreateTilePairCount(draw_options);
+
+  // Occlusion culled count, read back from stats.
+  gpu::Buffer culled_count_buffer;
+  if (draw_options.occlusion_culling) {
+    culled_count_buffer = gpu::Buffer::Create(VK_BUFFER_USAGE_TRANSFER_DST_BIT, sizeof(uint32_t), true);
+  }
+
   // Compute queue
   {
     gpu::ComputeTask task;
@@ -122,23 +473,51 @@ RenderingTask RendererImpl::Draw(GaussianSplats splats, const DrawOptions& draw_
     // Compute
     ComputeScreenSplats(cb, splats, draw_options, screen_splats, timer);
 
+    if (culled_count_buffer) {
+      gpu::cmd::Barrier()
+          .Memory(VK_PIPELINE_STAGE_2_COMPUTE_SHADER_BIT, VK_ACCESS_2_SHADER_WRITE_BIT,
+                  VK_PIPELINE_STAGE_2_TRANSFER_BIT, VK_ACCESS_2_TRANSFER_READ_BIT)
+          .Commit(cb);
+
+      VkBufferCopy region = {offsetof(Stats, occlusion_culled_count), 0, sizeof(uint32_t)};
+      vkCmdCopyBuffer(cb, screen_splats->stats(), culled_count_buffer, 1, &region);
+
+      gpu::cmd::Barrier()
+          .Memory(VK_PIPELINE_STAGE_2_TRANSFER_BIT, VK_ACCESS_2_TRANSFER_WRITE_BIT, VK_PIPELINE_STAGE_2_HOST_BIT,
+                  VK_ACCESS_2_HOST_READ_BIT)
+          .Commit(cb);
+
+      culled_count_buffer->Keep();
+    }
+
     // Release
     gpu::cmd::Barrier()
         .Release(VK_PIPELINE_STAGE_2_COMPUTE_SHADER_BIT, VK_ACCESS_2_SHADER_WRITE_BIT, cq, gq,
                  screen_splats->instances())
         .Release(VK_PIPELINE_STAGE_2_COMPUTE_SHADER_BIT, VK_ACCESS_2_SHADER_WRITE_BIT, cq, gq,
                  screen_splats->draw_indirect())
+        .Release(VK_PIPELINE_STAGE_2_COMPUTE_SHADER_BIT, VK_ACCESS_2_SHADER_WRITE_BIT, cq, gq,
+                 screen_splats->visible_point_count())
         .Commit(cb);
 
-    // G[i-2].read before C[i].comp
+    // G[i-R].read before C[i].comp
     task.WaitIf(gval >= 2, gsem, gval - 2 + 1,
                 VK_PIPELINE_STAGE_2_COMPUTE_SHADER_BIT | VK_PIPELINE_STAGE_2_TRANSFER_BIT);
     // C[i].comp
     task.Signal(csem, cval + 1, VK_PIPELINE_STAGE_2_COMPUTE_SHADER_BIT);
   }
 
-  auto image = graphics_storage->image();
   auto image_u8 = graphics_storage->image_u8();
+  auto readback = GetReadback(dst, OutputSize(draw_options), 4, ring_buffer.readback);
+
+  // Depth outputs are copied along with the color output, by the same queue.
+  Readback depth_readback = {};
+  if (draw_options.output_depth) {
+    graphics_storage->UpdateDepthOutputs();
+    depth_readback = GetReadback(reinterpret_cast<uint8_t*>(depth_dst), DepthOutputSize(draw_options), 16,
+                                 ring_buffer.depth_readback);
+  }
+  auto depth_outputs = graphics_storage->depth_outputs();
 
   // Graphics queue
   {
@@ -147,120 +526,126 @@ RenderingTask RendererImpl::Draw(GaussianSplats splats, const DrawOptions& draw_
 
     // Acquire
     gpu::cmd::Barrier()
-        .Acquire(VK_PIPELINE_STAGE_2_VERTEX_SHADER_BIT, VK_ACCESS_2_SHADER_READ_BIT, cq, gq, screen_splats->instances())
-        .Acquire(VK_PIPELINE_STAGE_2_DRAW_INDIRECT_BIT, VK_ACCESS_2_INDIRECT_COMMAND_READ_BIT, cq, gq,
+        .Acquire(VK_PIPELINE_STAGE_2_VERTEX_SHADER_BIT | VK_PIPELINE_STAGE_2_COMPUTE_SHADER_BIT,
+                 VK_ACCESS_2_SHADER_READ_BIT, cq, gq, screen_splats->instances())
+        .Acquire(VK_PIPELINE_STAGE_2_DRAW_INDIRECT_BIT | VK_PIPELINE_STAGE_2_VERTEX_SHADER_BIT,
+                 VK_ACCESS_2_INDIRECT_COMMAND_READ_BIT | VK_ACCESS_2_SHADER_READ_BIT, cq, gq,
                  screen_splats->draw_indirect())
+        .Acquire(VK_PIPELINE_STAGE_2_COMPUTE_SHADER_BIT, VK_ACCESS_2_SHADER_READ_BIT, cq, gq,
+                 screen_splats->visible_point_count())
         .Commit(cb);
 
-    // Layout transition to color attachment
-    gpu::cmd::Barrier()
-        .Image(0, 0, VK_PIPELINE_STAGE_2_COLOR_ATTACHMENT_OUTPUT_BIT, VK_ACCESS_2_COLOR_ATTACHMENT_WRITE_BIT,
-               VK_IMAGE_LAYOUT_UNDEFINED, VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL, image)
-        .Commit(cb);
-
-    // Rendering
-    VkRenderingAttachmentInfo color_attachment = {
-        .sType = VK_STRUCTURE_TYPE_RENDERING_ATTACHMENT_INFO,
-        .imageView = image->image_view(),
-        .imageLayout = VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL,
-        .loadOp = VK_ATTACHMENT_LOAD_OP_CLEAR,
-        .storeOp = VK_ATTACHMENT_STORE_OP_STORE,
-        .clearValue = {draw_options.background.r, draw_options.background.g, draw_options.background.b, 0.f},
-    };
-    VkRenderingInfo rendering_info = {
-        .sType = VK_STRUCTURE_TYPE_RENDERING_INFO,
-        .renderArea = {{0, 0}, {width, height}},
-        .layerCount = 1,
-        .colorAttachmentCount = 1,
-        .pColorAttachments = &color_attachment,
-    };
-    vkCmdBeginRendering(cb, &rendering_info);
-
-    VkViewport viewport = {0.f, 0.f, static_cast<float>(width), static_cast<float>(height), 0.f, 1.f};
-    vkCmdSetViewport(cb, 0, 1, &viewport);
-    VkRect2D scissor = {0, 0, width, height};
-    vkCmdSetScissor(cb, 0, 1, &scissor);
-
-    RenderTargetOptions render_target_options = {
-        .formats = {image->format()},
-        .locations = {0},
-    };
-    RenderScreenSplatsColor(cb, screen_splats, screen_splat_options, render_target_options);
-
-    vkCmdEndRendering(cb);
-
-    // float -> uint8
-    gpu::cmd::Barrier()
-        .Image(VK_PIPELINE_STAGE_2_COLOR_ATTACHMENT_OUTPUT_BIT, VK_ACCESS_2_COLOR_ATTACHMENT_WRITE_BIT,
-               VK_PIPELINE_STAGE_2_BLIT_BIT, VK_ACCESS_2_TRANSFER_READ_BIT, VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL,
-               VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL, image)
-        .Image(0, 0, VK_PIPELINE_STAGE_2_BLIT_BIT, VK_ACCESS_2_TRANSFER_WRITE_BIT, VK_IMAGE_LAYOUT_UNDEFINED,
-               VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, image_u8)
-        .Commit(cb);
-
-    VkImageBlit image_region = {
-        .srcSubresource = {VK_IMAGE_ASPECT_COLOR_BIT, 0, 0, 1},
-        .srcOffsets = {{0, 0, 0}, {static_cast<int>(width), static_cast<int>(height), 1}},
-        .dstSubresource = {VK_IMAGE_ASPECT_COLOR_BIT, 0, 0, 1},
-        .dstOffsets = {{0, 0, 0}, {static_cast<int>(width), static_cast<int>(height), 1}},
-    };
-    vkCmdBlitImage(cb, image, VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL, image_u8, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, 1,
-                   &image_region, VK_FILTER_NEAREST);
-
-    timer->Record(cb, VK_PIPELINE_STAGE_2_BLIT_BIT);
-
-    // Layout transition to transfer src, and release
-    gpu::cmd::Barrier()
-        .Release(VK_PIPELINE_STAGE_2_BLIT_BIT, VK_ACCESS_2_TRANSFER_WRITE_BIT, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
-                 VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL, gq, tq, image_u8)
-        .Commit(cb);
+    RenderScreenSplatsImage(cb, screen_splats, N, draw_options, screen_splat_options, graphics_storage,
+                            fragment_statistics, tile_pair_count);
+
+    if (build_hiz) {
+      gpu::cmd::Barrier()
+          .Release(VK_PIPELINE_STAGE_2_COMPUTE_SHADER_BIT, VK_ACCESS_2_SHADER_WRITE_BIT, gq, cq,
+                   graphics_storage->hiz())
+          .Commit(cb);
+      graphics_storage->SetHiz(draw_options.view, draw_options.projection);
+    } else {
+      graphics_storage->InvalidateHiz();
+    }
+
+    if (convert_output) {
+      ConvertOutput(cb, graphics_storage->image(), draw_options, readback.buffer, readback.offset);
+      if (draw_options.output_depth) {
+        CopyDepthOutputs(cb, graphics_storage, draw_options, depth_readback.buffer, depth_readback.offset);
+      }
+
+      gpu::cmd::Barrier()
+          .Memory(VK_PIPELINE_STAGE_2_COMPUTE_SHADER_BIT | VK_PIPELINE_STAGE_2_COPY_BIT,
+                  VK_ACCESS_2_SHADER_WRITE_BIT | VK_ACCESS_2_TRANSFER_WRITE_BIT, VK_PIPELINE_STAGE_2_HOST_BIT,
+                  VK_ACCESS_2_HOST_READ_BIT)
+          .Commit(cb);
+
+      timer->Record(cb, VK_PIPELINE_STAGE_2_COMPUTE_SHADER_BIT);
+    } else {
+      timer->Record(cb, VK_PIPELINE_STAGE_2_BLIT_BIT);
+
+      // Layout transition to transfer src, and release
+      gpu::cmd::Barrier barrier;
+      barrier.Release(VK_PIPELINE_STAGE_2_BLIT_BIT, VK_ACCESS_2_TRANSFER_WRITE_BIT,
+                      VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL, gq, tq, image_u8);
+      if (draw_options.output_depth) {
+        barrier.Release(VK_PIPELINE_STAGE_2_COPY_BIT, 0, VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL,
+                        VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL, gq, tq, depth_outputs);
+      }
+      barrier.Commit(cb);
+    }
 
     // C[i].comp before G[i].read
     task.Wait(csem, cval + 1,
               VK_PIPELINE_STAGE_2_DRAW_INDIRECT_BIT | VK_PIPELINE_STAGE_2_INDEX_INPUT_BIT |
-                  VK_PIPELINE_STAGE_2_VERTEX_SHADER_BIT);
-    // T[i-2].xfer before G[i].output
-    task.Wait(tsem, tval - 1 + 1, VK_PIPELINE_STAGE_2_COLOR_ATTACHMENT_OUTPUT_BIT);
+                  VK_PIPELINE_STAGE_2_VERTEX_SHADER_BIT | VK_PIPELINE_STAGE_2_COMPUTE_SHADER_BIT);
+    // T[i-R].xfer before G[i].output. Tile rasterization writes depth outputs in compute.
+    VkPipelineStageFlags2 output_stages =
+        VK_PIPELINE_STAGE_2_COLOR_ATTACHMENT_OUTPUT_BIT | VK_PIPELINE_STAGE_2_BLIT_BIT;
+    if (draw_options.output_depth) output_stages |= VK_PIPELINE_STAGE_2_COMPUTE_SHADER_BIT;
+    task.Wait(tsem, tval - 1 + 1, output_stages);
     // G[i].read
     task.Signal(gsem, gval + 1,
                 VK_PIPELINE_STAGE_2_DRAW_INDIRECT_BIT | VK_PIPELINE_STAGE_2_INDEX_INPUT_BIT |
-                    VK_PIPELINE_STAGE_2_VERTEX_SHADER_BIT);
-    // G[i].blit
-    task.Signal(gsem, gval + 2, VK_PIPELINE_STAGE_2_BLIT_BIT);
+                    VK_PIPELINE_STAGE_2_VERTEX_SHADER_BIT | VK_PIPELINE_STAGE_2_COMPUTE_SHADER_BIT);
+    // G[i].blit, or G[i].output if converted
+    task.Signal(gsem, gval + 2,
+                (convert_output ? VK_PIPELINE_STAGE_2_COMPUTE_SHADER_BIT : VK_PIPELINE_STAGE_2_BLIT_BIT) |
+                    VK_PIPELINE_STAGE_2_COPY_BIT);
   }
 
-  auto image_buffer = gpu::Buffer::Create(VK_BUFFER_USAGE_TRANSFER_DST_BIT, width * height * 4, true);
   gpu::QueueTask queue_task;
   {
     gpu::TransferTask task;
     auto cb = task.command_buffer();
 
-    gpu::cmd::Barrier()
-        .Acquire(VK_PIPELINE_STAGE_2_TRANSFER_BIT, VK_ACCESS_2_TRANSFER_READ_BIT, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
-                 VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL, gq, tq, image_u8)
-        .Commit(cb);
+    // Converted output is already in the readback buffer.
+    if (!convert_output) {
+      gpu::cmd::Barrier()
+          .Acquire(VK_PIPELINE_STAGE_2_TRANSFER_BIT, VK_ACCESS_2_TRANSFER_READ_BIT,
+                   VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL, gq, tq, image_u8)
+          .Commit(cb);
+
+      // Image to buffer
+      VkBufferImageCopy region = {
+          .bufferOffset = readback.offset,
+          .bufferRowLength = 0,
+          .bufferImageHeight = 0,
+          .imageSubresource = {VK_IMAGE_ASPECT_COLOR_BIT, 0, 0, 1},
+          .imageOffset = {0, 0, 0},
+          .imageExtent = {width, height, 1},
+      };
+      vkCmdCopyImageToBuffer(cb, image_u8, VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL, readback.buffer, 1, &region);
 
-    // Image to buffer
-    VkBufferImageCopy region = {
-        .bufferOffset = 0,
-        .bufferRowLength = 0,
-        .bufferImageHeight = 0,
-        .imageSubresource = {VK_IMAGE_ASPECT_COLOR_BIT, 0, 0, 1},
-        .imageOffset = {0, 0, 0},
-        .imageExtent = {width, height, 1},
-    };
-    vkCmdCopyImageToBuffer(cb, image_u8, VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL, image_buffer, 1, &region);
+      if (draw_options.output_depth) {
+        gpu::cmd::Barrier()
+            .Acquire(VK_PIPELINE_STAGE_2_TRANSFER_BIT, VK_ACCESS_2_TRANSFER_READ_BIT,
+                     VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL, VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL, gq, tq, depth_outputs)
+            .Commit(cb);
+        CopyDepthOutputs(cb, graphics_storage, draw_options, depth_readback.buffer, depth_readback.offset);
+      }
+    }
 
     timer->Record(cb, VK_PIPELINE_STAGE_2_TRANSFER_BIT);
 
-    task.PostCallback([width, height, image_buffer, dst, timer, rendering_task] {
-      std::memcpy(dst, image_buffer->data<uint8_t>(), width * height * 4);
+    size_t output_size = OutputSize(draw_options);
+    size_t depth_output_size = draw_options.output_depth ? DepthOutputSize(draw_options) : 0;
+    task.PostCallback([output_size, readback, dst, depth_output_size, depth_readback, depth_dst, timer,
+                       fragment_statistics, culled_count_buffer, tile_pair_count, tile_pair_demand = tile_pair_demand_,
+                       rendering_task] {
+      if (!readback.imported) std::memcpy(dst, readback.buffer->data<uint8_t>(), output_size);
+      if (depth_output_size > 0 && !depth_readback.imported) {
+        std::memcpy(depth_dst, depth_readback.buffer->data<uint8_t>(), depth_output_size);
+      }
 
       auto timestamps = timer->GetTimestamps();
       DrawResult draw_result = {
           .compute_timestamp = timestamps[0],
           .graphics_timestamp = timestamps[1],
           .transfer_timestamp = timestamps[2],
+          .fragment_count = fragment_statistics ? fragment_statistics->GetSum() : 0,
+          .occlusion_culled_count = culled_count_buffer ? *culled_count_buffer->data<uint32_t>() : 0,
+          .dropped_tile_pair_count = DroppedTilePairCount(tile_pair_count, *tile_pair_demand),
       };
       rendering_task->SetDrawResult(draw_result);
     });
@@ -272,6 +657,8 @@ RenderingTask RendererImpl::Draw(GaussianSplats splats, const DrawOptions& draw_
     queue_task = task.Submit();
   }
 
+  KeepReadback(readback, ring_buffer.readback, queue_task);
+  KeepReadback(depth_readback, ring_buffer.depth_readback, queue_task);
   rendering_task->SetTask(queue_task);
 
   csem->Increment();
@@ -283,144 +670,1272 @@ RenderingTask RendererImpl::Draw(GaussianSplats splats, const DrawOptions& draw_
   return rendering_task;
 }
 
-void RendererImpl::ComputeScreenSplats(VkCommandBuffer cb, GaussianSplats splats, const DrawOptions& draw_options,
-                                       ScreenSplats screen_splats, gpu::Timer timer) {
-  auto N = splats->size();
-  auto position_opacity = splats->position_opacity();
-  auto cov3d = splats->cov3d();
-  auto sh = splats->sh();
-  auto opacity_sh = splats->opacity_sh();
-
-  const auto& ring_buffer = ring_buffer_[frame_index_ % ring_buffer_.size()];
-  auto compute_storage = ring_buffer.compute_storage;
-  auto requirements = sorter_->GetStorageRequirements(N);
-  compute_storage->Update(N, requirements.usage, requirements.size);
+std::vector<RenderingTask> RendererImpl::DrawBatch(GaussianSplats splats, const std::vector<DrawOptions>& draw_options,
+                                                   const ScreenSplatOptions& screen_splat_options, uint8_t* dst,
+                                                   float* depth_dst) {
+  return DrawViews(splats, draw_options, screen_splat_options, dst, depth_dst, false);
+}
 
-  auto key = compute_storage->key();
-  auto index = compute_storage->index();
-  auto sort_storage = compute_storage->sort_storage();
-  auto inverse_index = compute_storage->inverse_index();
-  auto camera = compute_storage->camera();
-  auto camera_stage = compute_storage->camera_stage();
+std::vector<RenderingTask> RendererImpl::DrawStereo(GaussianSplats splats,
+                                                    const std::vector<DrawOptions>& draw_options,
+                                                    const ScreenSplatOptions& screen_splat_options, uint8_t* dst,
+                                                    float* depth_dst) {
+  if (draw_options.size() % 2 != 0) throw std::runtime_error("DrawStereo: views must come in pairs");
+  for (size_t i = 0; i < draw_options.size(); i += 2) {
+    const auto& left = draw_options[i];
+    const auto& right = draw_options[i + 1];
+    if (left.model != right.model || left.rasterizer != right.rasterizer || left.front_to_back != right.front_to_back ||
+        left.deterministic != right.deterministic) {
+      throw std::runtime_error("DrawStereo: eyes of a pair must have the same model, rasterizer and sort options");
+    }
+  }
+  return DrawViews(splats, draw_options, screen_splat_options, dst, depth_dst, true);
+}
 
-  auto visible_point_count = screen_splats->visible_point_count();
-  auto draw_indirect = screen_splats->draw_indirect();
-  auto instances = screen_splats->instances();
-  auto stats = screen_splats->stats();
+std::vector<RenderingTask> RendererImpl::DrawTiled(GaussianSplats splats, const DrawOptions& image_options,
+                                                   const ScreenSplatOptions& screen_splat_options, uint8_t* dst,
+                                                   float* depth_dst, uint32_t tile_size) {
+  auto draw_options = RoiOptions(image_options);
+  if (tile_size == 0 || tile_size > max_image_size_) {
+    throw std::runtime_error("DrawTiled: tile size must be in [1, " + std::to_string(max_image_size_) + "]");
+  }
 
-  ProjectionPushConstants projection_push_constants = {
-      .model = draw_options.model,
-      .point_count = static_cast<uint32_t>(N),
-      .eps2d = draw_options.eps2d,
-      .sh_degree_data = splats->sh_degree(),
-      .sh_degree_draw = draw_options.sh_degree == -1 ? splats->sh_degree() : draw_options.sh_degree,
-      .record_stat = draw_options.record_stat,
-      .opacity_degree = splats->opacity_degree(),
+  // Edge tiles are rendered at full tile size, and only their region is copied.
+  TiledOutput tiled_output = {
+      .width = draw_options.width,
+      .height = draw_options.height,
   };
+  std::vector<DrawOptions> tile_options;
+  for (uint32_t y = 0; y < draw_options.height; y += tile_size) {
+    for (uint32_t x = 0; x < draw_options.width; x += tile_size) {
+      glm::uvec2 size = glm::min(glm::uvec2(tile_size), glm::uvec2(draw_options.width - x, draw_options.height - y));
+      tiled_output.regions.push_back({x, y, size.x, size.y});
+      tile_options.push_back(CropOptions(draw_options, {x, y}, glm::uvec2(tile_size)));
+    }
+  }
 
-  Camera camera_data = {
-      .projection = draw_options.projection,
-      .view = draw_options.view,
-      .camera_position = glm::inverse(draw_options.view)[3],
-      .screen_size = glm::uvec2(draw_options.width, draw_options.height),
-  };
-  std::memcpy(camera_stage->data(), &camera_data, sizeof(Camera));
+  return DrawViews(splats, tile_options, screen_splat_options, dst, depth_dst, false, &tiled_output);
+}
 
-  VkBufferCopy region = {0, 0, sizeof(Camera)};
-  vkCmdCopyBuffer(cb, camera_stage, camera, 1, &region);
-  vkCmdFillBuffer(cb, visible_point_count, 0, sizeof(uint32_t), 0);
-  vkCmdFillBuffer(cb, inverse_index, 0, N * sizeof(uint32_t), -1);
-  if (draw_options.record_stat) vkCmdFillBuffer(cb, stats, 0, stats->size(), 0);
+std::vector<RenderingTask> RendererImpl::DrawCubemap(GaussianSplats splats, const DrawOptions& draw_options,
+                                                     const ScreenSplatOptions& screen_splat_options, uint8_t* dst,
+                                                     uint32_t equirect_width) {
+  if (draw_options.width != draw_options.height) throw std::runtime_error("DrawCubemap: faces must be square");
+  if (draw_options.output_depth) throw std::runtime_error("DrawCubemap: depth outputs are not supported");
+  if (draw_options.roi.z != 0 || draw_options.roi.w != 0) {
+    throw std::runtime_error("DrawCubemap: region of interest is not supported");
+  }
 
-  gpu::cmd::Barrier()
-      .Memory(VK_PIPELINE_STAGE_2_TRANSFER_BIT, VK_ACCESS_2_TRANSFER_WRITE_BIT, VK_PIPELINE_STAGE_2_COMPUTE_SHADER_BIT,
-              VK_ACCESS_2_SHADER_READ_BIT | VK_ACCESS_2_SHADER_WRITE_BIT)
-      .Commit(cb);
+  std::vector<DrawOptions> face_options(kCubeFaces.size());
+  for (size_t i = 0; i < kCubeFaces.size(); ++i) face_options[i] = CubeFaceOptions(draw_options, i);
 
-  // Rank
-  gpu::cmd::Pipeline pipeline(VK_PIPELINE_BIND_POINT_COMPUTE, compute_pipeline_layout_);
-  pipeline.Storage(0, camera)
-      .Storage(1, position_opacity)
-      .Storage(2, visible_point_count)
-      .Storage(3, key)
-      .Storage(4, index)
-      .PushConstant(VK_SHADER_STAGE_COMPUTE_BIT, 0, sizeof(projection_push_constants), &projection_push_constants)
-      .Bind(rank_pipeline_)
-      .Commit(cb);
-  vkCmdDispatch(cb, WorkgroupSize(N, 256), 1, 1);
+  if (equirect_width == 0) return DrawViews(splats, face_options, screen_splat_options, dst, nullptr, false);
 
-  // Sort
-  gpu::cmd::Barrier()
-      .Memory(VK_PIPELINE_STAGE_2_COMPUTE_SHADER_BIT, VK_ACCESS_2_SHADER_WRITE_BIT,
-              VK_PIPELINE_STAGE_2_COMPUTE_SHADER_BIT | VK_PIPELINE_STAGE_2_TRANSFER_BIT,
-              VK_ACCESS_2_SHADER_READ_BIT | VK_ACCESS_2_TRANSFER_READ_BIT)
-      .Commit(cb);
+  if (equirect_width % 2 != 0) throw std::runtime_error("DrawCubemap: equirect width must be even");
 
-  sorter_->SortKeyValueIndirect(cb, N, visible_point_count, key, index, sort_storage);
+  // Faces are converted to float16 for resampling, the panorama to the output format.
+  for (auto& options : face_options) {
+    options.output_format = OutputFormat::RGBA16F;
+    options.output_planar = false;
+    options.output_srgb = false;
+  }
+  auto equirect_options = draw_options;
+  equirect_options.width = equirect_width;
+  equirect_options.height = equirect_width / 2;
 
-  // Inverse index
-  gpu::cmd::Barrier()
-      .Memory(VK_PIPELINE_STAGE_2_COMPUTE_SHADER_BIT, VK_ACCESS_2_SHADER_WRITE_BIT,
-              VK_PIPELINE_STAGE_2_COMPUTE_SHADER_BIT, VK_ACCESS_2_SHADER_READ_BIT)
-      .Commit(cb);
+  uint32_t face_size = draw_options.width;
+  uint32_t face_count = face_options.size();
+  size_t face_image_size = OutputSize(face_options[0]);
 
-  pipeline.Storage(0, visible_point_count)
-      .Storage(1, index)
-      .Storage(2, inverse_index)
-      .PushConstant(VK_SHADER_STAGE_COMPUTE_BIT, 0, sizeof(projection_push_constants), &projection_push_constants)
-      .Bind(inverse_index_pipeline_)
-      .Commit(cb);
-  vkCmdDispatch(cb, WorkgroupSize(N, 256), 1, 1);
+  auto N = splats->size();
+  auto rendering_task = RenderingTask::Create();
 
-  // Projection
-  gpu::cmd::Barrier()
-      .Memory(VK_PIPELINE_STAGE_2_COMPUTE_SHADER_BIT, VK_ACCESS_2_SHADER_WRITE_BIT,
-              VK_PIPELINE_STAGE_2_COMPUTE_SHADER_BIT, VK_ACCESS_2_SHADER_READ_BIT)
-      .Commit(cb);
+  // Semaphores belong to the batch ring slot, so the previous values are of submission c-R for ring size R.
+  auto& batch_buffer = batch_buffer_[batch_index_ % batch_buffer_.size()];
+  auto compute_storage = batch_buffer.compute_storage;
+  auto graphics_storage = batch_buffer.graphics_storage;
+  auto csem = batch_buffer.compute_semaphore;
+  auto cval = csem->value();
+  auto gsem = batch_buffer.graphics_semaphore;
+  auto gval = gsem->value();
 
-  pipeline.Storage(0, camera)
-      .Storage(1, position_opacity)
-      .Storage(2, cov3d)
-      .Storage(3, sh)
-      .Storage(4, opacity_sh)
-      .Storage(5, visible_point_count)
-      .Storage(6, inverse_index)
-      .Storage(7, draw_indirect)
-      .Storage(8, instances)
-      .Storage(9, stats)
-      .Bind(projection_pipeline_)
-      .Commit(cb);
-  vkCmdDispatch(cb, WorkgroupSize(N, 256), 1, 1);
+  auto cq = compute_queue_index_;
+  auto gq = graphics_queue_index_;
 
-  if (timer) {
-    timer->Record(cb, VK_PIPELINE_STAGE_2_COMPUTE_SHADER_BIT);
+  // Faces share one rank, sort and projection where supported, as in DrawViews. Splats are classified into the faces
+  // whose frustum they touch by the rank pass, and one sort orders the pairs of all faces.
+  bool batched = face_count <= ComputeStorageImpl::kMaxBatchViews && face_count * N <= kBatchPairCapacity &&
+                 SupportsBatchedCompute(face_options);
+  // Batched compute sets shared instances instead.
+  if (!batched) {
+    for (uint32_t i = 0; i < face_count; ++i) batch_buffer.screen_splats[i]->Update(N);
   }
-
-  if (draw_options.record_stat) {
+  graphics_storage->Update(face_size, face_size);
+  graphics_storage->InvalidateHiz();
+  graphics_storage->UpdateCubemap(equirect_options.width, equirect_options.height);
+  auto cube_faces = graphics_storage->cube_faces();
+  auto equirect_image = graphics_storage->equirect();
+
+  std::vector<gpu::PipelineStatistics> fragment_statistics(face_count);
+  std::vector<gpu::Buffer> tile_pair_counts(face_count);
+  for (uint32_t i = 0; i < face_count; ++i) {
+    tile_pair_counts[i] = CreateTilePairCount(face_options[i]);
+    if (pipeline_statistics_query_ && draw_options.rasterizer != Rasterizer::TILE) {
+      fragment_statistics[i] = gpu::PipelineStatistics::Create(
+          VK_QUERY_PIPELINE_STATISTIC_FRAGMENT_SHADER_INVOCATIONS_BIT, ScreenSplatsImpl::kDrawChunkCount);
+    }
   }
 
-  visible_point_count->Keep();
-  key->Keep();
-  index->Keep();
-  sort_storage->Keep();
-  inverse_index->Keep();
-  camera->Keep();
-  camera_stage->Keep();
-  draw_indirect->Keep();
-  instances->Keep();
-  if (draw_options.record_stat) stats->Keep();
+  // Compute timestamps per face or one for the batched pass, then graphics and transfer timestamps.
+  uint32_t compute_timestamp_count = batched ? 1 : face_count;
+  auto timer = gpu::Timer::Create(compute_timestamp_count + 2);
 
-  screen_splats->SetIndexBuffer(splats->index_buffer());
-  screen_splats->SetProjection(draw_options.projection);
-}
+  // Compute queue
+  {
+    gpu::ComputeTask task;
+    auto cb = task.command_buffer();
 
-void RendererImpl::RenderScreenSplatsColor(VkCommandBuffer cb, ScreenSplats screen_splats,
-                                           const ScreenSplatOptions& screen_splat_options,
-                                           const RenderTargetOptions& render_target_options) {
-  auto splat_color_pipeline = gpu::GraphicsPipeline::Create({
+    for (uint32_t i = 0; i < (batched ? 1 : face_count); ++i) {
+      // Compute storage is shared by the faces, and with previous submissions of the slot.
+      gpu::cmd::Barrier()
+          .Memory(VK_PIPELINE_STAGE_2_COMPUTE_SHADER_BIT | VK_PIPELINE_STAGE_2_TRANSFER_BIT,
+                  VK_ACCESS_2_SHADER_WRITE_BIT | VK_ACCESS_2_TRANSFER_WRITE_BIT,
+                  VK_PIPELINE_STAGE_2_COMPUTE_SHADER_BIT | VK_PIPELINE_STAGE_2_TRANSFER_BIT,
+                  VK_ACCESS_2_SHADER_READ_BIT | VK_ACCESS_2_SHADER_WRITE_BIT | VK_ACCESS_2_TRANSFER_WRITE_BIT)
+          .Commit(cb);
+
+      if (batched) {
+        std::vector<ScreenSplats> face_screen_splats(batch_buffer.screen_splats.begin(),
+                                                     batch_buffer.screen_splats.begin() + face_count);
+        ComputeScreenSplatsBatch(cb, splats, face_options, face_screen_splats, compute_storage, timer);
+      } else {
+        ComputeScreenSplats(cb, splats, face_options[i], batch_buffer.screen_splats[i], compute_storage,
+                            graphics_storage, timer);
+      }
+    }
+
+    gpu::cmd::Barrier release;
+    for (uint32_t i = 0; i < face_count; ++i) {
+      const auto& screen_splats = batch_buffer.screen_splats[i];
+      // Instances of batched compute are shared, and transferred once.
+      if (!batched || i == 0) {
+        release.Release(VK_PIPELINE_STAGE_2_COMPUTE_SHADER_BIT, VK_ACCESS_2_SHADER_WRITE_BIT, cq, gq,
+                        screen_splats->instances());
+      }
+      release
+          .Release(VK_PIPELINE_STAGE_2_COMPUTE_SHADER_BIT, VK_ACCESS_2_SHADER_WRITE_BIT, cq, gq,
+                   screen_splats->draw_indirect())
+          .Release(VK_PIPELINE_STAGE_2_COMPUTE_SHADER_BIT, VK_ACCESS_2_SHADER_WRITE_BIT, cq, gq,
+                   screen_splats->visible_point_count());
+    }
+    release.Commit(cb);
+
+    // G[c-R] before C[c]
+    task.WaitIf(gval >= 1, gsem, gval, VK_PIPELINE_STAGE_2_COMPUTE_SHADER_BIT | VK_PIPELINE_STAGE_2_TRANSFER_BIT);
+    // C[c]
+    task.Signal(csem, cval + 1, VK_PIPELINE_STAGE_2_COMPUTE_SHADER_BIT);
+  }
+
+  size_t output_size = OutputSize(equirect_options);
+  auto readback = GetReadback(dst, output_size, 4, batch_buffer.readback);
+
+  // Graphics queue, including resampling and readback
+  gpu::QueueTask queue_task;
+  {
+    gpu::GraphicsTask task;
+    auto cb = task.command_buffer();
+
+    gpu::cmd::Barrier barrier;
+    for (uint32_t i = 0; i < face_count; ++i) {
+      const auto& screen_splats = batch_buffer.screen_splats[i];
+      if (!batched || i == 0) {
+        barrier.Acquire(VK_PIPELINE_STAGE_2_VERTEX_SHADER_BIT | VK_PIPELINE_STAGE_2_COMPUTE_SHADER_BIT,
+                        VK_ACCESS_2_SHADER_READ_BIT, cq, gq, screen_splats->instances());
+      }
+      barrier
+          .Acquire(VK_PIPELINE_STAGE_2_DRAW_INDIRECT_BIT | VK_PIPELINE_STAGE_2_VERTEX_SHADER_BIT,
+                   VK_ACCESS_2_INDIRECT_COMMAND_READ_BIT | VK_ACCESS_2_SHADER_READ_BIT, cq, gq,
+                   screen_splats->draw_indirect())
+          .Acquire(VK_PIPELINE_STAGE_2_COMPUTE_SHADER_BIT, VK_ACCESS_2_SHADER_READ_BIT, cq, gq,
+                   screen_splats->visible_point_count());
+    }
+    barrier.Commit(cb);
+
+    for (uint32_t i = 0; i < face_count; ++i) {
+      // Graphics storage is shared by the faces, and by previous submissions in this queue.
+      gpu::cmd::Barrier()
+          .Memory(VK_PIPELINE_STAGE_2_ALL_COMMANDS_BIT, VK_ACCESS_2_MEMORY_WRITE_BIT,
+                  VK_PIPELINE_STAGE_2_ALL_COMMANDS_BIT, VK_ACCESS_2_MEMORY_READ_BIT | VK_ACCESS_2_MEMORY_WRITE_BIT)
+          .Commit(cb);
+
+      RenderScreenSplatsImage(cb, batch_buffer.screen_splats[i], N, face_options[i], screen_splat_options,
+                              graphics_storage, fragment_statistics[i], tile_pair_counts[i]);
+      ConvertOutput(cb, graphics_storage->image(), face_options[i], cube_faces, i * face_image_size);
+    }
+
+    // Resample
+    gpu::cmd::Barrier()
+        .Memory(VK_PIPELINE_STAGE_2_COMPUTE_SHADER_BIT, VK_ACCESS_2_SHADER_WRITE_BIT,
+                VK_PIPELINE_STAGE_2_COMPUTE_SHADER_BIT, VK_ACCESS_2_SHADER_READ_BIT)
+        .Image(0, 0, VK_PIPELINE_STAGE_2_COMPUTE_SHADER_BIT, VK_ACCESS_2_SHADER_WRITE_BIT, VK_IMAGE_LAYOUT_UNDEFINED,
+               VK_IMAGE_LAYOUT_GENERAL, equirect_image)
+        .Commit(cb);
+
+    EquirectPushConstants push_constants = {
+        .screen_size = {equirect_options.width, equirect_options.height},
+        .face_size = face_size,
+        .ndc_sign_x = face_options[0].projection[0][0],
+        .ndc_sign_y = face_options[0].projection[1][1],
+    };
+    gpu::cmd::Pipeline(VK_PIPELINE_BIND_POINT_COMPUTE, output_pipeline_layout_)
+        .StorageImage(0, equirect_image->image_view(), VK_IMAGE_LAYOUT_GENERAL)
+        .Storage(1, cube_faces)
+        .PushConstant(VK_SHADER_STAGE_COMPUTE_BIT, 0, sizeof(push_constants), &push_constants)
+        .Bind(equirect_pipeline_)
+        .Commit(cb);
+    vkCmdDispatch(cb, WorkgroupSize(equirect_options.width, 16), WorkgroupSize(equirect_options.height, 16), 1);
+
+    gpu::cmd::Barrier()
+        .Image(VK_PIPELINE_STAGE_2_COMPUTE_SHADER_BIT, VK_ACCESS_2_SHADER_WRITE_BIT,
+               VK_PIPELINE_STAGE_2_COMPUTE_SHADER_BIT, VK_ACCESS_2_SHADER_READ_BIT, VK_IMAGE_LAYOUT_GENERAL,
+               VK_IMAGE_LAYOUT_GENERAL, equirect_image)
+        .Commit(cb);
+
+    timer->Record(cb, VK_PIPELINE_STAGE_2_COMPUTE_SHADER_BIT);
+
+    ConvertOutput(cb, equirect_image, equirect_options, readback.buffer, readback.offset);
+
+    gpu::cmd::Barrier()
+        .Memory(VK_PIPELINE_STAGE_2_COMPUTE_SHADER_BIT, VK_ACCESS_2_SHADER_WRITE_BIT, VK_PIPELINE_STAGE_2_HOST_BIT,
+                VK_ACCESS_2_HOST_READ_BIT)
+        .Commit(cb);
+
+    timer->Record(cb, VK_PIPELINE_STAGE_2_COMPUTE_SHADER_BIT);
+
+    task.PostCallback([compute_timestamp_count, output_size, readback, dst, timer, fragment_statistics,
+                       tile_pair_counts, tile_pair_demand = tile_pair_demand_, rendering_task] {
+      if (!readback.imported) std::memcpy(dst, readback.buffer->data<uint8_t>(), output_size);
+
+      auto timestamps = timer->GetTimestamps();
+      uint64_t fragment_count = 0;
+      for (const auto& statistics : fragment_statistics) {
+        if (statistics) fragment_count += statistics->GetSum();
+      }
+      uint32_t dropped_tile_pair_count = 0;
+      for (const auto& tile_pair_count : tile_pair_counts) {
+        dropped_tile_pair_count += DroppedTilePairCount(tile_pair_count, *tile_pair_demand);
+      }
+      DrawResult draw_result = {
+          .compute_timestamp = timestamps[compute_timestamp_count - 1],
+          .graphics_timestamp = timestamps[compute_timestamp_count],
+          .transfer_timestamp = timestamps[compute_timestamp_count + 1],
+          .fragment_count = fragment_count,
+          .dropped_tile_pair_count = dropped_tile_pair_count,
+      };
+      rendering_task->SetDrawResult(draw_result);
+    });
+
+    // C[c] before G[c]
+    task.Wait(csem, cval + 1,
+              VK_PIPELINE_STAGE_2_DRAW_INDIRECT_BIT | VK_PIPELINE_STAGE_2_INDEX_INPUT_BIT |
+                  VK_PIPELINE_STAGE_2_VERTEX_SHADER_BIT | VK_PIPELINE_STAGE_2_COMPUTE_SHADER_BIT);
+    // G[c]
+    task.Signal(gsem, gval + 1, VK_PIPELINE_STAGE_2_ALL_COMMANDS_BIT);
+    queue_task = task.Submit();
+  }
+
+  KeepReadback(readback, batch_buffer.readback, queue_task);
+  rendering_task->SetTask(queue_task);
+
+  csem->Increment();
+  gsem->Increment();
+  batch_index_++;
+
+  return {rendering_task};
+}
+
+std::vector<RenderingTask> RendererImpl::DrawViews(GaussianSplats splats,
+                                                   const std::vector<DrawOptions>& image_options,
+                                                   const ScreenSplatOptions& screen_splat_options, uint8_t* dst,
+                                                   float* depth_dst, bool stereo, const TiledOutput* tiled_output) {
+  std::vector<RenderingTask> rendering_tasks;
+  if (image_options.empty()) return rendering_tasks;
+
+  std::vector<DrawOptions> draw_options;
+  for (const auto& options : image_options) draw_options.push_back(RoiOptions(options));
+
+  uint32_t width = draw_options[0].width;
+  uint32_t height = draw_options[0].height;
+  if (width > max_image_size_ || height > max_image_size_) {
+    throw std::runtime_error("DrawBatch: size exceeds the device limit of " + std::to_string(max_image_size_) +
+                             ", use DrawTiled");
+  }
+  for (const auto& options : draw_options) {
+    if (options.width != width || options.height != height) {
+      throw std::runtime_error("DrawBatch: all views must have the same size");
+    }
+    if (options.output_format != draw_options[0].output_format ||
+        options.output_planar != draw_options[0].output_planar ||
+        options.output_srgb != draw_options[0].output_srgb) {
+      throw std::runtime_error("DrawBatch: all views must have the same output format");
+    }
+    if (options.output_depth != draw_options[0].output_depth) {
+      throw std::runtime_error("DrawBatch: all views must have the same outputs");
+    }
+    if (options.output_depth && !SupportsDepthOutputs(options)) {
+      throw std::runtime_error("DrawBatch: depth outputs are not supported with front_to_back or OIT");
+    }
+  }
+
+  auto N = splats->size();
+  size_t image_size = OutputSize(draw_options[0]);
+  bool convert_output = ConvertsOutput(draw_options[0]);
+  bool output_depth = draw_options[0].output_depth;
+  size_t depth_image_size = DepthOutputSize(draw_options[0]);
+
+  auto cq = compute_queue_index_;
+  auto gq = graphics_queue_index_;
+
+  // Views sharing compute are chunked by as many as fit their pairs, even if all points are visible in all of them.
+  size_t batch_view_count = std::min<size_t>({ComputeStorageImpl::kMaxBatchViews, draw_options.size(),
+                                              kBatchPairCapacity / std::max<size_t>(N, 1)});
+  bool batched = !stereo && batch_view_count > 1 && SupportsBatchedCompute(draw_options);
+  uint32_t chunk_size = batched ? batch_view_count : kBatchChunkSize;
+
+  for (size_t first = 0; first < draw_options.size(); first += chunk_size) {
+    uint32_t count = std::min<size_t>(chunk_size, draw_options.size() - first);
+
+    // Chunks rotate through the batch ring slots, so that chunk c only waits for the graphics queue of chunk c-R for
+    // ring size R. Semaphores belong to the slot, so their previous values are of that chunk.
+    auto& batch_buffer = batch_buffer_[batch_index_ % batch_buffer_.size()];
+    auto compute_storage = batch_buffer.compute_storage;
+    auto graphics_storage = batch_buffer.graphics_storage;
+    auto csem = batch_buffer.compute_semaphore;
+    auto cval = csem->value();
+    auto gsem = batch_buffer.graphics_semaphore;
+    auto gval = gsem->value();
+
+    auto& batch_screen_splats = batch_buffer.screen_splats;
+    while (batch_screen_splats.size() < chunk_size) batch_screen_splats.push_back(ScreenSplats::Create());
+    // Batched compute sets shared instances instead.
+    if (!batched) {
+      for (uint32_t i = 0; i < count; ++i) batch_screen_splats[i]->Update(N);
+    }
+    graphics_storage->Update(width, height);
+    graphics_storage->InvalidateHiz();
+    if (output_depth) graphics_storage->UpdateDepthOutputs();
+
+    std::vector<DrawOptions> chunk_options(draw_options.begin() + first, draw_options.begin() + first + count);
+    for (auto& options : chunk_options) options.occlusion_culling = false;
+
+    std::vector<RenderingTask> chunk_tasks(count);
+    std::vector<gpu::PipelineStatistics> fragment_statistics(count);
+    std::vector<gpu::Buffer> tile_pair_counts(count);
+    for (uint32_t i = 0; i < count; ++i) {
+      chunk_tasks[i] = RenderingTask::Create();
+      tile_pair_counts[i] = CreateTilePairCount(chunk_options[i]);
+      if (pipeline_statistics_query_ && chunk_options[i].rasterizer != Rasterizer::TILE) {
+        fragment_statistics[i] = gpu::PipelineStatistics::Create(
+            VK_QUERY_PIPELINE_STATISTIC_FRAGMENT_SHADER_INVOCATIONS_BIT, ScreenSplatsImpl::kDrawChunkCount);
+      }
+    }
+
+    // Compute timestamps of the chunk first, one per view or one for the batched pass, then graphics and transfer
+    // timestamps per view.
+    uint32_t compute_timestamp_count = batched ? 1 : count;
+    auto timer = gpu::Timer::Create(compute_timestamp_count + 2 * count);
+
+    // Compute queue
+    {
+      gpu::ComputeTask task;
+      auto cb = task.command_buffer();
+
+      if (batched) {
+        // Compute storage is shared with previous chunks of the slot.
+        gpu::cmd::Barrier()
+            .Memory(VK_PIPELINE_STAGE_2_COMPUTE_SHADER_BIT | VK_PIPELINE_STAGE_2_TRANSFER_BIT,
+                    VK_ACCESS_2_SHADER_WRITE_BIT | VK_ACCESS_2_TRANSFER_WRITE_BIT,
+                    VK_PIPELINE_STAGE_2_COMPUTE_SHADER_BIT | VK_PIPELINE_STAGE_2_TRANSFER_BIT,
+                    VK_ACCESS_2_SHADER_READ_BIT | VK_ACCESS_2_SHADER_WRITE_BIT | VK_ACCESS_2_TRANSFER_WRITE_BIT)
+            .Commit(cb);
+
+        std::vector<ScreenSplats> chunk_screen_splats(batch_screen_splats.begin(), batch_screen_splats.begin() + count);
+        ComputeScreenSplatsBatch(cb, splats, chunk_options, chunk_screen_splats, compute_storage, timer);
+      }
+
+      // Stereo pairs share one visibility and sort pass, chunks hold whole pairs.
+      for (uint32_t i = 0; i < count && !batched; i += stereo ? 2 : 1) {
+        const auto& screen_splats = batch_screen_splats;
+
+        // Compute storage is shared by the views of the chunk.
+        gpu::cmd::Barrier()
+            .Memory(VK_PIPELINE_STAGE_2_COMPUTE_SHADER_BIT | VK_PIPELINE_STAGE_2_TRANSFER_BIT,
+                    VK_ACCESS_2_SHADER_WRITE_BIT | VK_ACCESS_2_TRANSFER_WRITE_BIT,
+                    VK_PIPELINE_STAGE_2_COMPUTE_SHADER_BIT | VK_PIPELINE_STAGE_2_TRANSFER_BIT,
+                    VK_ACCESS_2_SHADER_READ_BIT | VK_ACCESS_2_SHADER_WRITE_BIT | VK_ACCESS_2_TRANSFER_WRITE_BIT)
+            .Commit(cb);
+
+        if (stereo) {
+          ComputeScreenSplats(cb, splats, chunk_options[i], screen_splats[i], compute_storage, graphics_storage, timer,
+                              &chunk_options[i + 1], screen_splats[i + 1]);
+        } else {
+          ComputeScreenSplats(cb, splats, chunk_options[i], screen_splats[i], compute_storage, graphics_storage,
+                              timer);
+        }
+      }
+
+      gpu::cmd::Barrier release;
+      for (uint32_t i = 0; i < count; ++i) {
+        const auto& screen_splats = batch_screen_splats[i];
+        // Instances of batched compute are shared, and transferred once.
+        if (!batched || i == 0) {
+          release.Release(VK_PIPELINE_STAGE_2_COMPUTE_SHADER_BIT, VK_ACCESS_2_SHADER_WRITE_BIT, cq, gq,
+                          screen_splats->instances());
+        }
+        release
+            .Release(VK_PIPELINE_STAGE_2_COMPUTE_SHADER_BIT, VK_ACCESS_2_SHADER_WRITE_BIT, cq, gq,
+                     screen_splats->draw_indirect())
+            .Release(VK_PIPELINE_STAGE_2_COMPUTE_SHADER_BIT, VK_ACCESS_2_SHADER_WRITE_BIT, cq, gq,
+                     screen_splats->visible_point_count());
+      }
+      release.Commit(cb);
+
+      // G[c-R] before C[c]
+      task.WaitIf(gval >= 1, gsem, gval, VK_PIPELINE_STAGE_2_COMPUTE_SHADER_BIT | VK_PIPELINE_STAGE_2_TRANSFER_BIT);
+      // C[c]
+      task.Signal(csem, cval + 1, VK_PIPELINE_STAGE_2_COMPUTE_SHADER_BIT);
+    }
+
+    // Tiles are read back to the pools, and copied into place by the host.
+    TiledOutput chunk_tiled_output = {};
+    if (tiled_output) {
+      chunk_tiled_output = {
+          .width = tiled_output->width,
+          .height = tiled_output->height,
+          .regions = {tiled_output->regions.begin() + first, tiled_output->regions.begin() + first + count},
+      };
+    }
+
+    auto image_u8 = graphics_storage->image_u8();
+    uint8_t* chunk_dst = tiled_output ? nullptr : dst + first * image_size;
+    auto readback = GetReadback(chunk_dst, count * image_size, 4, batch_buffer.readback);
+
+    float* chunk_depth_dst = nullptr;
+    Readback depth_readback = {};
+    if (output_depth) {
+      if (!tiled_output) chunk_depth_dst = depth_dst + first * depth_image_size / sizeof(float);
+      depth_readback = GetReadback(reinterpret_cast<uint8_t*>(chunk_depth_dst), count * depth_image_size, 16,
+                                   batch_buffer.depth_readback);
+    }
+
+    // Graphics queue, including readback
+    gpu::QueueTask queue_task;
+    {
+      gpu::GraphicsTask task;
+      auto cb = task.command_buffer();
+
+      gpu::cmd::Barrier barrier;
+      for (uint32_t i = 0; i < count; ++i) {
+        const auto& screen_splats = batch_screen_splats[i];
+        if (!batched || i == 0) {
+          barrier.Acquire(VK_PIPELINE_STAGE_2_VERTEX_SHADER_BIT | VK_PIPELINE_STAGE_2_COMPUTE_SHADER_BIT,
+                          VK_ACCESS_2_SHADER_READ_BIT, cq, gq, screen_splats->instances());
+        }
+        barrier
+            .Acquire(VK_PIPELINE_STAGE_2_DRAW_INDIRECT_BIT | VK_PIPELINE_STAGE_2_VERTEX_SHADER_BIT,
+                     VK_ACCESS_2_INDIRECT_COMMAND_READ_BIT | VK_ACCESS_2_SHADER_READ_BIT, cq, gq,
+                     screen_splats->draw_indirect())
+            .Acquire(VK_PIPELINE_STAGE_2_COMPUTE_SHADER_BIT, VK_ACCESS_2_SHADER_READ_BIT, cq, gq,
+                     screen_splats->visible_point_count());
+      }
+      barrier.Commit(cb);
+
+      for (uint32_t i = 0; i < count; ++i) {
+        // Graphics storage is shared by the views of the chunk, and by previous chunks of the slot in this queue.
+        gpu::cmd::Barrier()
+            .Memory(VK_PIPELINE_STAGE_2_ALL_COMMANDS_BIT, VK_ACCESS_2_MEMORY_WRITE_BIT,
+                    VK_PIPELINE_STAGE_2_ALL_COMMANDS_BIT, VK_ACCESS_2_MEMORY_READ_BIT | VK_ACCESS_2_MEMORY_WRITE_BIT)
+            .Commit(cb);
+
+        RenderScreenSplatsImage(cb, batch_screen_splats[i], N, chunk_options[i], screen_splat_options,
+                                graphics_storage, fragment_statistics[i], tile_pair_counts[i]);
+
+        if (output_depth) {
+          CopyDepthOutputs(cb, graphics_storage, chunk_options[i], depth_readback.buffer,
+                           depth_readback.offset + i * depth_image_size);
+        }
+
+        if (convert_output) {
+          timer->Record(cb, VK_PIPELINE_STAGE_2_ALL_COMMANDS_BIT);
+          // Words shared with the previous view are merged after its conversion, ordered by the barrier above.
+          ConvertOutput(cb, graphics_storage->image(), chunk_options[i], readback.buffer,
+                        readback.offset + i * image_size);
+          timer->Record(cb, VK_PIPELINE_STAGE_2_COMPUTE_SHADER_BIT);
+          continue;
+        }
+
+        timer->Record(cb, VK_PIPELINE_STAGE_2_BLIT_BIT);
+
+        gpu::cmd::Barrier()
+            .Image(VK_PIPELINE_STAGE_2_BLIT_BIT, VK_ACCESS_2_TRANSFER_WRITE_BIT, VK_PIPELINE_STAGE_2_COPY_BIT,
+                   VK_ACCESS_2_TRANSFER_READ_BIT, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
+                   VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL, image_u8)
+            .Commit(cb);
+
+        VkBufferImageCopy region = {
+            .bufferOffset = readback.offset + i * image_size,
+            .bufferRowLength = 0,
+            .bufferImageHeight = 0,
+            .imageSubresource = {VK_IMAGE_ASPECT_COLOR_BIT, 0, 0, 1},
+            .imageOffset = {0, 0, 0},
+            .imageExtent = {width, height, 1},
+        };
+        vkCmdCopyImageToBuffer(cb, image_u8, VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL, readback.buffer, 1, &region);
+
+        timer->Record(cb, VK_PIPELINE_STAGE_2_COPY_BIT);
+      }
+
+      gpu::cmd::Barrier()
+          .Memory(VK_PIPELINE_STAGE_2_COPY_BIT | VK_PIPELINE_STAGE_2_COMPUTE_SHADER_BIT,
+                  VK_ACCESS_2_TRANSFER_WRITE_BIT | VK_ACCESS_2_SHADER_WRITE_BIT, VK_PIPELINE_STAGE_2_HOST_BIT,
+                  VK_ACCESS_2_HOST_READ_BIT)
+          .Commit(cb);
+
+      uint32_t plane_count = chunk_options[0].output_planar ? OutputChannelCount(chunk_options[0]) : 1;
+      size_t texel_size = OutputSize(chunk_options[0]) / (static_cast<size_t>(width) * height) / plane_count;
+      task.PostCallback([count, image_size, readback, chunk_dst, output_depth, depth_image_size, depth_readback,
+                         chunk_depth_dst, chunk_tiled_output, dst, depth_dst, width, plane_count, texel_size, timer,
+                         batched, compute_timestamp_count, fragment_statistics, tile_pair_counts,
+                         tile_pair_demand = tile_pair_demand_, chunk_tasks] {
+        if (!chunk_tiled_output.regions.empty()) {
+          const auto& [image_width, image_height, regions] = chunk_tiled_output;
+          for (uint32_t i = 0; i < count; ++i) {
+            CopyTile(readback.buffer->data<uint8_t>() + i * image_size, dst, image_width, image_height, width,
+                     regions[i], plane_count, texel_size);
+            if (output_depth) {
+              CopyTile(depth_readback.buffer->data<uint8_t>() + i * depth_image_size,
+                       reinterpret_cast<uint8_t*>(depth_dst), image_width, image_height, width, regions[i], 1,
+                       4 * sizeof(float));
+            }
+          }
+        } else {
+          if (!readback.imported) std::memcpy(chunk_dst, readback.buffer->data<uint8_t>(), count * image_size);
+          if (output_depth && !depth_readback.imported) {
+            std::memcpy(chunk_depth_dst, depth_readback.buffer->data<uint8_t>(), count * depth_image_size);
+          }
+        }
+
+        auto timestamps = timer->GetTimestamps();
+        for (uint32_t i = 0; i < count; ++i) {
+          DrawResult draw_result = {
+              .compute_timestamp = timestamps[batched ? 0 : i],
+              .graphics_timestamp = timestamps[compute_timestamp_count + 2 * i + 0],
+              .transfer_timestamp = timestamps[compute_timestamp_count + 2 * i + 1],
+              .fragment_count = fragment_statistics[i] ? fragment_statistics[i]->GetSum() : 0,
+              .dropped_tile_pair_count = DroppedTilePairCount(tile_pair_counts[i], *tile_pair_demand),
+          };
+          chunk_tasks[i]->SetDrawResult(draw_result);
+        }
+      });
+
+      // C[c] before G[c]
+      task.Wait(csem, cval + 1,
+                VK_PIPELINE_STAGE_2_DRAW_INDIRECT_BIT | VK_PIPELINE_STAGE_2_INDEX_INPUT_BIT |
+                    VK_PIPELINE_STAGE_2_VERTEX_SHADER_BIT | VK_PIPELINE_STAGE_2_COMPUTE_SHADER_BIT);
+      // G[c]
+      task.Signal(gsem, gval + 1, VK_PIPELINE_STAGE_2_ALL_COMMANDS_BIT);
+      queue_task = task.Submit();
+    }
+
+    KeepReadback(readback, batch_buffer.readback, queue_task);
+    KeepReadback(depth_readback, batch_buffer.depth_readback, queue_task);
+    for (auto& rendering_task : chunk_tasks) {
+      rendering_task->SetTask(queue_task);
+      rendering_tasks.push_back(rendering_task);
+    }
+
+    csem->Increment();
+    gsem->Increment();
+    batch_index_++;
+  }
+
+  return rendering_tasks;
+}
+
+void RendererImpl::RenderScreenSplatsImage(VkCommandBuffer cb, ScreenSplats screen_splats, size_t point_count,
+                                           const DrawOptions& draw_options,
+                                           const ScreenSplatOptions& screen_splat_options,
+                                           GraphicsStorage graphics_storage,
+                                           gpu::PipelineStatistics fragment_statistics, gpu::Buffer tile_pair_count) {
+  uint32_t width = draw_options.width;
+  uint32_t height = draw_options.height;
+  auto image = graphics_storage->image();
+  auto image_u8 = graphics_storage->image_u8();
+  auto depth_outputs = graphics_storage->depth_outputs();
+
+  VkImageLayout image_layout;
+  VkPipelineStageFlags2 image_stage;
+  VkAccessFlags2 image_access;
+  if (draw_options.rasterizer == Rasterizer::TILE) {
+    RasterizeScreenSplatsTile(cb, screen_splats, point_count, draw_options, screen_splat_options, graphics_storage,
+                              tile_pair_count);
+
+    image_layout = VK_IMAGE_LAYOUT_GENERAL;
+    image_stage = VK_PIPELINE_STAGE_2_COMPUTE_SHADER_BIT;
+    image_access = VK_ACCESS_2_SHADER_WRITE_BIT;
+
+    if (draw_options.output_depth) {
+      gpu::cmd::Barrier()
+          .Image(VK_PIPELINE_STAGE_2_COMPUTE_SHADER_BIT, VK_ACCESS_2_SHADER_WRITE_BIT, VK_PIPELINE_STAGE_2_COPY_BIT,
+                 VK_ACCESS_2_TRANSFER_READ_BIT, VK_IMAGE_LAYOUT_GENERAL, VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL,
+                 depth_outputs)
+          .Commit(cb);
+    }
+  } else if (draw_options.rasterizer == Rasterizer::OIT) {
+    RenderScreenSplatsOit(cb, screen_splats, draw_options, screen_splat_options, graphics_storage,
+                          fragment_statistics);
+
+    image_layout = VK_IMAGE_LAYOUT_RENDERING_LOCAL_READ;
+    image_stage = VK_PIPELINE_STAGE_2_COLOR_ATTACHMENT_OUTPUT_BIT;
+    image_access = VK_ACCESS_2_COLOR_ATTACHMENT_WRITE_BIT;
+  } else if (draw_options.front_to_back) {
+    RenderScreenSplatsFrontToBack(cb, screen_splats, draw_options, screen_splat_options, graphics_storage,
+                                  fragment_statistics);
+
+    if (BuildsHiz(draw_options)) BuildHiz(cb, graphics_storage);
+
+    image_layout = VK_IMAGE_LAYOUT_RENDERING_LOCAL_READ;
+    image_stage = VK_PIPELINE_STAGE_2_COLOR_ATTACHMENT_OUTPUT_BIT;
+    image_access = VK_ACCESS_2_COLOR_ATTACHMENT_WRITE_BIT;
+  } else {
+    // Layout transition to color attachment
+    gpu::cmd::Barrier barrier;
+    barrier.Image(0, 0, VK_PIPELINE_STAGE_2_COLOR_ATTACHMENT_OUTPUT_BIT, VK_ACCESS_2_COLOR_ATTACHMENT_WRITE_BIT,
+                  VK_IMAGE_LAYOUT_UNDEFINED, VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL, image);
+    if (draw_options.output_depth) {
+      barrier.Image(0, 0, VK_PIPELINE_STAGE_2_COLOR_ATTACHMENT_OUTPUT_BIT, VK_ACCESS_2_COLOR_ATTACHMENT_WRITE_BIT,
+                    VK_IMAGE_LAYOUT_UNDEFINED, VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL, depth_outputs);
+    }
+    barrier.Commit(cb);
+
+    // Rendering, with depth outputs as a second render target cleared to 0.
+    std::vector<VkRenderingAttachmentInfo> color_attachments = {{
+        .sType = VK_STRUCTURE_TYPE_RENDERING_ATTACHMENT_INFO,
+        .imageView = image->image_view(),
+        .imageLayout = VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL,
+        .loadOp = VK_ATTACHMENT_LOAD_OP_CLEAR,
+        .storeOp = VK_ATTACHMENT_STORE_OP_STORE,
+        .clearValue = {draw_options.background.r, draw_options.background.g, draw_options.background.b, 0.f},
+    }};
+    RenderTargetOptions render_target_options = {
+        .formats = {image->format()},
+        .locations = {0},
+    };
+    if (draw_options.output_depth) {
+      color_attachments.push_back({
+          .sType = VK_STRUCTURE_TYPE_RENDERING_ATTACHMENT_INFO,
+          .imageView = depth_outputs->image_view(),
+          .imageLayout = VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL,
+          .loadOp = VK_ATTACHMENT_LOAD_OP_CLEAR,
+          .storeOp = VK_ATTACHMENT_STORE_OP_STORE,
+          .clearValue = {0.f, 0.f, 0.f, 0.f},
+      });
+      render_target_options.formats.push_back(depth_outputs->format());
+      render_target_options.locations.push_back(1);
+      render_target_options.depth_outputs = true;
+    }
+
+    VkRenderingInfo rendering_info = {
+        .sType = VK_STRUCTURE_TYPE_RENDERING_INFO,
+        .renderArea = {{0, 0}, {width, height}},
+        .layerCount = 1,
+        .colorAttachmentCount = static_cast<uint32_t>(color_attachments.size()),
+        .pColorAttachments = color_attachments.data(),
+    };
+    vkCmdBeginRendering(cb, &rendering_info);
+
+    VkViewport viewport = {0.f, 0.f, static_cast<float>(width), static_cast<float>(height), 0.f, 1.f};
+    vkCmdSetViewport(cb, 0, 1, &viewport);
+    VkRect2D scissor = {0, 0, width, height};
+    vkCmdSetScissor(cb, 0, 1, &scissor);
+
+    if (fragment_statistics) fragment_statistics->Begin(cb);
+    RenderScreenSplatsColor(cb, screen_splats, screen_splat_options, render_target_options);
+    if (fragment_statistics) fragment_statistics->End(cb);
+
+    vkCmdEndRendering(cb);
+
+    if (draw_options.output_depth) {
+      // Normalize expected depth in place.
+      gpu::cmd::Barrier()
+          .Image(VK_PIPELINE_STAGE_2_COLOR_ATTACHMENT_OUTPUT_BIT, VK_ACCESS_2_COLOR_ATTACHMENT_WRITE_BIT,
+                 VK_PIPELINE_STAGE_2_COMPUTE_SHADER_BIT, VK_ACCESS_2_SHADER_READ_BIT | VK_ACCESS_2_SHADER_WRITE_BIT,
+                 VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL, VK_IMAGE_LAYOUT_GENERAL, depth_outputs)
+          .Commit(cb);
+
+      OutputPushConstants push_constants = {
+          .screen_size = {width, height},
+      };
+      gpu::cmd::Pipeline(VK_PIPELINE_BIND_POINT_COMPUTE, output_pipeline_layout_)
+          .StorageImage(0, depth_outputs->image_view(), VK_IMAGE_LAYOUT_GENERAL)
+          .PushConstant(VK_SHADER_STAGE_COMPUTE_BIT, 0, sizeof(push_constants), &push_constants)
+          .Bind(depth_resolve_pipeline_)
+          .Commit(cb);
+      vkCmdDispatch(cb, WorkgroupSize(width, 16), WorkgroupSize(height, 16), 1);
+
+      gpu::cmd::Barrier()
+          .Image(VK_PIPELINE_STAGE_2_COMPUTE_SHADER_BIT, VK_ACCESS_2_SHADER_WRITE_BIT, VK_PIPELINE_STAGE_2_COPY_BIT,
+                 VK_ACCESS_2_TRANSFER_READ_BIT, VK_IMAGE_LAYOUT_GENERAL, VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL,
+                 depth_outputs)
+          .Commit(cb);
+      depth_outputs->Keep();
+    }
+
+    image_layout = VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL;
+    image_stage = VK_PIPELINE_STAGE_2_COLOR_ATTACHMENT_OUTPUT_BIT;
+    image_access = VK_ACCESS_2_COLOR_ATTACHMENT_WRITE_BIT;
+  }
+
+  if (ConvertsOutput(draw_options)) {
+    gpu::cmd::Barrier()
+        .Image(image_stage, image_access, VK_PIPELINE_STAGE_2_COMPUTE_SHADER_BIT, VK_ACCESS_2_SHADER_READ_BIT,
+               image_layout, VK_IMAGE_LAYOUT_GENERAL, image)
+        .Commit(cb);
+    return;
+  }
+
+  // float -> uint8
+  gpu::cmd::Barrier()
+      .Image(image_stage, image_access, VK_PIPELINE_STAGE_2_BLIT_BIT, VK_ACCESS_2_TRANSFER_READ_BIT, image_layout,
+             VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL, image)
+      .Image(0, 0, VK_PIPELINE_STAGE_2_BLIT_BIT, VK_ACCESS_2_TRANSFER_WRITE_BIT, VK_IMAGE_LAYOUT_UNDEFINED,
+             VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, image_u8)
+      .Commit(cb);
+
+  VkImageBlit image_region = {
+      .srcSubresource = {VK_IMAGE_ASPECT_COLOR_BIT, 0, 0, 1},
+      .srcOffsets = {{0, 0, 0}, {static_cast<int>(width), static_cast<int>(height), 1}},
+      .dstSubresource = {VK_IMAGE_ASPECT_COLOR_BIT, 0, 0, 1},
+      .dstOffsets = {{0, 0, 0}, {static_cast<int>(width), static_cast<int>(height), 1}},
+  };
+  vkCmdBlitImage(cb, image, VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL, image_u8, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, 1,
+                 &image_region, VK_FILTER_NEAREST);
+}
+
+void RendererImpl::ConvertOutput(VkCommandBuffer cb, gpu::Image image, const DrawOptions& draw_options,
+                                 gpu::Buffer buffer, VkDeviceSize byte_offset) {
+  VkDeviceSize output_size = OutputSize(draw_options);
+  if (byte_offset + output_size > buffer->size()) throw std::runtime_error("Output exceeds the readback buffer");
+
+  // Outputs beyond the storage buffer range, or 32-bit byte addresses in the shader, are converted by segments, each
+  // bound at an aligned offset. Segments are whole multiples of 16 bytes, so that they start at element boundaries.
+  auto device = gpu::GetDevice();
+  VkDeviceSize alignment = std::max<VkDeviceSize>(device->min_storage_buffer_offset_alignment(), 4);
+  VkDeviceSize max_range = std::min<VkDeviceSize>(device->max_storage_buffer_range(), 1ull << 31);
+  if (max_range < alignment + 20) throw std::runtime_error("Storage buffer range is too small for output conversion");
+  VkDeviceSize segment_size = (max_range - alignment - 4) / 16 * 16;
+  uint32_t element_size = OutputElementSize(draw_options);
+
+  for (VkDeviceSize first = 0; first < output_size; first += segment_size) {
+    VkDeviceSize count = std::min(segment_size, output_size - first);
+    VkDeviceSize begin = byte_offset + first;
+    VkDeviceSize range_offset = begin / alignment * alignment;
+    VkDeviceSize range = std::min((begin + count + 3) / 4 * 4, buffer->size()) - range_offset;
+
+    OutputPushConstants push_constants = {
+        .screen_size = {draw_options.width, draw_options.height},
+        .format = static_cast<uint32_t>(draw_options.output_format),
+        .planar = draw_options.output_planar,
+        .srgb = draw_options.output_srgb,
+        .byte_offset = static_cast<uint32_t>(begin - range_offset),
+        .byte_count = static_cast<uint32_t>(count),
+        .element_offset = static_cast<uint32_t>(first / element_size),
+    };
+
+    // One invocation per output word, strided over at most kMaxOutputWorkgroups workgroups.
+    constexpr uint32_t kMaxOutputWorkgroups = 4096;
+    size_t word_count = (begin + count + 3) / 4 - begin / 4;
+    uint32_t workgroup_count = std::min<size_t>(WorkgroupSize(word_count, 256), kMaxOutputWorkgroups);
+
+    gpu::cmd::Pipeline(VK_PIPELINE_BIND_POINT_COMPUTE, output_pipeline_layout_)
+        .StorageImage(0, image->image_view(), VK_IMAGE_LAYOUT_GENERAL)
+        .Storage(1, buffer, range_offset, range)
+        .PushConstant(VK_SHADER_STAGE_COMPUTE_BIT, 0, sizeof(push_constants), &push_constants)
+        .Bind(output_pipeline_)
+        .Commit(cb);
+    vkCmdDispatch(cb, workgroup_count, 1, 1);
+  }
+}
+
+void RendererImpl::CopyDepthOutputs(VkCommandBuffer cb, GraphicsStorage graphics_storage,
+                                    const DrawOptions& draw_options, VkBuffer buffer, VkDeviceSize byte_offset) {
+  auto depth_outputs = graphics_storage->depth_outputs();
+  VkBufferImageCopy region = {
+      .bufferOffset = byte_offset,
+      .bufferRowLength = 0,
+      .bufferImageHeight = 0,
+      .imageSubresource = {VK_IMAGE_ASPECT_COLOR_BIT, 0, 0, 1},
+      .imageOffset = {0, 0, 0},
+      .imageExtent = {draw_options.width, draw_options.height, 1},
+  };
+  vkCmdCopyImageToBuffer(cb, depth_outputs, VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL, buffer, 1, &region);
+  depth_outputs->Keep();
+}
+
+void RendererImpl::ComputeScreenSplats(VkCommandBuffer cb, GaussianSplats splats, const DrawOptions& draw_options,
+                                       ScreenSplats screen_splats, gpu::Timer timer) {
+  const auto& ring_buffer = ring_buffer_[frame_index_ % ring_buffer_.size()];
+  ComputeScreenSplats(cb, splats, draw_options, screen_splats, ring_buffer.compute_storage,
+                      ring_buffer.graphics_storage, timer);
+}
+
+void RendererImpl::ComputeScreenSplats(VkCommandBuffer cb, GaussianSplats splats, const DrawOptions& draw_options,
+                                       ScreenSplats screen_splats, ComputeStorage compute_storage,
+                                       GraphicsStorage graphics_storage, gpu::Timer timer,
+                                       const DrawOptions* stereo_options, ScreenSplats stereo_screen_splats) {
+  auto N = splats->size();
+  auto position_opacity = splats->position_opacity();
+  auto cov3d = splats->cov3d();
+  auto sh = splats->sh();
+  auto opacity_sh = splats->opacity_sh();
+
+  auto requirements = sorter_->GetStorageRequirements(N);
+  compute_storage->Update(N, requirements.usage, requirements.size);
+
+  auto key = compute_storage->key();
+  auto index = compute_storage->index();
+  auto sort_storage = compute_storage->sort_storage();
+  auto workgroup_offset = compute_storage->workgroup_offset();
+  auto projection_dispatch = compute_storage->projection_dispatch();
+  auto camera = compute_storage->camera();
+  auto projection_uniforms = compute_storage->projection_uniforms();
+
+  auto visible_point_count = screen_splats->visible_point_count();
+  auto draw_indirect = screen_splats->draw_indirect();
+  auto instances = screen_splats->instances();
+  auto stats = screen_splats->stats();
+  auto hiz = graphics_storage->hiz();
+
+  // Depth pyramid of the previous frame in this slot, released by its graphics queue.
+  bool stereo = stereo_options != nullptr;
+  bool occlusion = !stereo && draw_options.occlusion_culling && graphics_storage->hiz_valid();
+  bool clear_stats = draw_options.record_stat || draw_options.occlusion_culling;
+  bool color_cache = draw_options.color_cache_angle > 0.f;
+
+  ProjectionPushConstants projection_push_constants = {
+      .model = draw_options.model,
+      .point_count = static_cast<uint32_t>(N),
+      .eps2d = draw_options.eps2d,
+      .sh_degree_data = splats->sh_degree(),
+      .sh_degree_draw = draw_options.sh_degree == -1 ? splats->sh_degree() : draw_options.sh_degree,
+      .record_stat = draw_options.record_stat,
+      .opacity_degree = splats->opacity_degree(),
+      // Tile rasterizer walks back-to-front ranks from the end, so it is front-to-back already.
+      .front_to_back = draw_options.front_to_back && draw_options.rasterizer == Rasterizer::HARDWARE,
+  };
+
+  Camera camera_data = {
+      .projection = draw_options.projection,
+      .view = draw_options.view,
+      .camera_position = glm::inverse(draw_options.view)[3],
+      .screen_size = glm::uvec2(draw_options.width, draw_options.height),
+  };
+  if (occlusion) {
+    camera_data.hiz_projection = graphics_storage->hiz_projection();
+    camera_data.hiz_view = graphics_storage->hiz_view();
+    camera_data.hiz_camera_position = glm::inverse(graphics_storage->hiz_view())[3];
+    camera_data.hiz_screen_size = graphics_storage->hiz_screen_size();
+    camera_data.hiz_level_count = graphics_storage->hiz_level_count();
+  }
+
+  if (stereo) {
+    // Rank in either eye, keyed by depth from the midpoint camera.
+    camera_data.view = MidpointView(draw_options.view, stereo_options->view);
+    camera_data.stereo_view_projection[0] = draw_options.projection * draw_options.view;
+    camera_data.stereo_view_projection[1] = stereo_options->projection * stereo_options->view;
+  }
+
+  ProjectionUniforms projection_uniforms_data = GetProjectionUniforms(draw_options);
+
+  // Inline in the command buffer, so that consecutive draws can be recorded together.
+  vkCmdUpdateBuffer(cb, camera, 0, sizeof(Camera), &camera_data);
+  vkCmdUpdateBuffer(cb, projection_uniforms, 0, sizeof(ProjectionUniforms), &projection_uniforms_data);
+  vkCmdFillBuffer(cb, visible_point_count, 0, sizeof(uint32_t), 0);
+  if (clear_stats) vkCmdFillBuffer(cb, stats, 0, stats->size(), 0);
+  if (color_cache && !splats->color_cache()) {
+    // Zero SH degree tags are never hit.
+    splats->SetColorCache(gpu::Buffer::Create(VK_BUFFER_USAGE_STORAGE_BUFFER_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT,
+                                              N * 2 * 4 * sizeof(uint16_t)));
+    vkCmdFillBuffer(cb, splats->color_cache(), 0, VK_WHOLE_SIZE, 0);
+  }
+
+  gpu::cmd::Barrier()
+      .Memory(VK_PIPELINE_STAGE_2_TRANSFER_BIT, VK_ACCESS_2_TRANSFER_WRITE_BIT, VK_PIPELINE_STAGE_2_COMPUTE_SHADER_BIT,
+              VK_ACCESS_2_SHADER_READ_BIT | VK_ACCESS_2_SHADER_WRITE_BIT | VK_ACCESS_2_UNIFORM_READ_BIT)
+      .Commit(cb);
+
+  if (occlusion) {
+    gpu::cmd::Barrier()
+        .Acquire(VK_PIPELINE_STAGE_2_COMPUTE_SHADER_BIT, VK_ACCESS_2_SHADER_READ_BIT, graphics_queue_index_,
+                 compute_queue_index_, hiz)
+        .Commit(cb);
+  }
+
+  // Rank
+  gpu::cmd::Pipeline pipeline(VK_PIPELINE_BIND_POINT_COMPUTE, compute_pipeline_layout_);
+  pipeline.Storage(0, camera)
+      .Storage(1, position_opacity)
+      .Storage(2, visible_point_count)
+      .Storage(3, key)
+      .Storage(4, index)
+      .Storage(5, workgroup_offset)
+      .PushConstant(VK_SHADER_STAGE_COMPUTE_BIT, 0, sizeof(projection_push_constants), &projection_push_constants);
+  if (occlusion) pipeline.Storage(6, cov3d).Storage(7, hiz).Storage(9, stats);
+
+  auto rank_pipeline = rank_pipeline_;
+  auto rank_count_pipeline = rank_count_pipeline_;
+  auto rank_deterministic_pipeline = rank_deterministic_pipeline_;
+  if (stereo) {
+    rank_pipeline = rank_stereo_pipeline_;
+    rank_count_pipeline = rank_count_stereo_pipeline_;
+    rank_deterministic_pipeline = rank_deterministic_stereo_pipeline_;
+  } else if (occlusion) {
+    rank_pipeline = rank_occlusion_pipeline_;
+    rank_count_pipeline = rank_count_occlusion_pipeline_;
+    rank_deterministic_pipeline = rank_deterministic_occlusion_pipeline_;
+  }
+
+  if (draw_options.deterministic) {
+    // Two-level scan: per-workgroup counts, then their exclusive scan as rank offsets.
+    pipeline.Bind(rank_count_pipeline).Commit(cb);
+    vkCmdDispatch(cb, WorkgroupSize(N, 256), 1, 1);
+
+    gpu::cmd::Barrier()
+        .Memory(VK_PIPELINE_STAGE_2_COMPUTE_SHADER_BIT, VK_ACCESS_2_SHADER_WRITE_BIT,
+                VK_PIPELINE_STAGE_2_COMPUTE_SHADER_BIT, VK_ACCESS_2_SHADER_READ_BIT | VK_ACCESS_2_SHADER_WRITE_BIT)
+        .Commit(cb);
+
+    pipeline.Bind(rank_scan_pipeline_).Commit(cb);
+    vkCmdDispatch(cb, 1, 1, 1);
+
+    gpu::cmd::Barrier()
+        .Memory(VK_PIPELINE_STAGE_2_COMPUTE_SHADER_BIT, VK_ACCESS_2_SHADER_WRITE_BIT,
+                VK_PIPELINE_STAGE_2_COMPUTE_SHADER_BIT, VK_ACCESS_2_SHADER_READ_BIT)
+        .Commit(cb);
+
+    pipeline.Bind(rank_deterministic_pipeline).Commit(cb);
+  } else {
+    pipeline.Bind(rank_pipeline).Commit(cb);
+  }
+  vkCmdDispatch(cb, WorkgroupSize(N, 256), 1, 1);
+
+  // Sort
+  gpu::cmd::Barrier()
+      .Memory(VK_PIPELINE_STAGE_2_COMPUTE_SHADER_BIT, VK_ACCESS_2_SHADER_WRITE_BIT,
+              VK_PIPELINE_STAGE_2_COMPUTE_SHADER_BIT | VK_PIPELINE_STAGE_2_TRANSFER_BIT,
+              VK_ACCESS_2_SHADER_READ_BIT | VK_ACCESS_2_TRANSFER_READ_BIT)
+      .Commit(cb);
+
+  // Order-independent blending draws splats in rank order.
+  if (draw_options.rasterizer != Rasterizer::OIT) {
+    sorter_->SortKeyValueIndirect(cb, N, visible_point_count, key, index, sort_storage);
+  }
+
+  // Indirect commands from visible point count, independent of sort.
+  pipeline.Storage(0, visible_point_count)
+      .Storage(1, projection_dispatch)
+      .Storage(2, draw_indirect)
+      .Bind(indirect_pipeline_)
+      .Commit(cb);
+  vkCmdDispatch(cb, 1, 1, 1);
+
+  // Projection, in sorted order over visible points. Stats may be written by rank too.
+  gpu::cmd::Barrier()
+      .Memory(VK_PIPELINE_STAGE_2_COMPUTE_SHADER_BIT, VK_ACCESS_2_SHADER_WRITE_BIT,
+              VK_PIPELINE_STAGE_2_COMPUTE_SHADER_BIT | VK_PIPELINE_STAGE_2_DRAW_INDIRECT_BIT,
+              VK_ACCESS_2_SHADER_READ_BIT | VK_ACCESS_2_SHADER_WRITE_BIT | VK_ACCESS_2_INDIRECT_COMMAND_READ_BIT)
+      .Commit(cb);
+
+  auto projection_pipeline =
+      draw_options.generic_projection
+          ? GetProjectionPipeline(kDynamicDegree, kDynamicDegree, color_cache)
+          : GetProjectionPipeline(splats->sh_degree(), splats->opacity_degree(), color_cache);
+  pipeline.Storage(1, position_opacity)
+      .Storage(2, cov3d)
+      .Storage(3, sh)
+      .Storage(4, opacity_sh)
+      .Storage(5, visible_point_count)
+      .Storage(6, index)
+      .Storage(8, instances)
+      .Storage(9, stats)
+      .Uniform(10, projection_uniforms)
+      .PushConstant(VK_SHADER_STAGE_COMPUTE_BIT, 0, sizeof(projection_push_constants), &projection_push_constants);
+  if (color_cache) pipeline.Storage(11, splats->color_cache());
+  pipeline.Bind(projection_pipeline).Commit(cb);
+  vkCmdDispatchIndirect(cb, projection_dispatch, 0);
+
+  if (timer) {
+    timer->Record(cb, VK_PIPELINE_STAGE_2_COMPUTE_SHADER_BIT);
+  }
+
+  // Second eye: same ranks and order, projected with its own camera.
+  if (stereo) {
+    auto stereo_visible_point_count = stereo_screen_splats->visible_point_count();
+    auto stereo_draw_indirect = stereo_screen_splats->draw_indirect();
+    auto stereo_instances = stereo_screen_splats->instances();
+
+    ProjectionPushConstants stereo_push_constants = projection_push_constants;
+    stereo_push_constants.eps2d = stereo_options->eps2d;
+    stereo_push_constants.sh_degree_draw =
+        stereo_options->sh_degree == -1 ? splats->sh_degree() : stereo_options->sh_degree;
+    ProjectionUniforms stereo_uniforms_data = GetProjectionUniforms(*stereo_options);
+
+    // The first projection reads uniforms and dispatch before they are overwritten.
+    gpu::cmd::Barrier()
+        .Memory(VK_PIPELINE_STAGE_2_COMPUTE_SHADER_BIT | VK_PIPELINE_STAGE_2_DRAW_INDIRECT_BIT, 0,
+                VK_PIPELINE_STAGE_2_TRANSFER_BIT, 0)
+        .Commit(cb);
+    vkCmdUpdateBuffer(cb, projection_uniforms, 0, sizeof(ProjectionUniforms), &stereo_uniforms_data);
+    VkBufferCopy region = {0, 0, sizeof(uint32_t)};
+    vkCmdCopyBuffer(cb, visible_point_count, stereo_visible_point_count, 1, &region);
+
+    gpu::cmd::Barrier()
+        .Memory(VK_PIPELINE_STAGE_2_TRANSFER_BIT, VK_ACCESS_2_TRANSFER_WRITE_BIT,
+                VK_PIPELINE_STAGE_2_COMPUTE_SHADER_BIT, VK_ACCESS_2_SHADER_READ_BIT | VK_ACCESS_2_UNIFORM_READ_BIT)
+        .Commit(cb);
+
+    pipeline.Storage(0, stereo_visible_point_count)
+        .Storage(1, projection_dispatch)
+        .Storage(2, stereo_draw_indirect)
+        .Bind(indirect_pipeline_)
+        .Commit(cb);
+    vkCmdDispatch(cb, 1, 1, 1);
+
+    // Color cache may be written by the first projection too.
+    gpu::cmd::Barrier()
+        .Memory(VK_PIPELINE_STAGE_2_COMPUTE_SHADER_BIT, VK_ACCESS_2_SHADER_WRITE_BIT,
+                VK_PIPELINE_STAGE_2_COMPUTE_SHADER_BIT | VK_PIPELINE_STAGE_2_DRAW_INDIRECT_BIT,
+                VK_ACCESS_2_SHADER_READ_BIT | VK_ACCESS_2_SHADER_WRITE_BIT | VK_ACCESS_2_INDIRECT_COMMAND_READ_BIT)
+        .Commit(cb);
+
+    pipeline.Storage(1, position_opacity)
+        .Storage(2, cov3d)
+        .Storage(3, sh)
+        .Storage(4, opacity_sh)
+        .Storage(5, stereo_visible_point_count)
+        .Storage(6, index)
+        .Storage(8, stereo_instances)
+        .Storage(9, stats)
+        .Uniform(10, projection_uniforms)
+        .PushConstant(VK_SHADER_STAGE_COMPUTE_BIT, 0, sizeof(stereo_push_constants), &stereo_push_constants);
+    if (color_cache) pipeline.Storage(11, splats->color_cache());
+    pipeline.Bind(projection_pipeline).Commit(cb);
+    vkCmdDispatchIndirect(cb, projection_dispatch, 0);
+
+    if (timer) {
+      timer->Record(cb, VK_PIPELINE_STAGE_2_COMPUTE_SHADER_BIT);
+    }
+
+    stereo_visible_point_count->Keep();
+    stereo_draw_indirect->Keep();
+    stereo_instances->Keep();
+
+    stereo_screen_splats->SetIndexBuffer(splats->index_buffer());
+    stereo_screen_splats->SetProjection(stereo_options->projection);
+  }
+
+  if (draw_options.record_stat) {
+  }
+
+  visible_point_count->Keep();
+  key->Keep();
+  index->Keep();
+  sort_storage->Keep();
+  workgroup_offset->Keep();
+  projection_dispatch->Keep();
+  camera->Keep();
+  projection_uniforms->Keep();
+  draw_indirect->Keep();
+  instances->Keep();
+  if (clear_stats) stats->Keep();
+  if (occlusion) hiz->Keep();
+  if (color_cache) splats->color_cache()->Keep();
+
+  screen_splats->SetIndexBuffer(splats->index_buffer());
+  screen_splats->SetProjection(draw_options.projection);
+}
+
+// Batch uniforms are updated inline, limited to 65536 bytes per vkCmdUpdateBuffer.
+static_assert(ComputeStorageImpl::kMaxBatchViews * sizeof(glm::mat4) <= 65536);
+static_assert(ComputeStorageImpl::kMaxBatchViews * sizeof(ProjectionUniforms) <= 65536);
+
+void RendererImpl::ComputeScreenSplatsBatch(VkCommandBuffer cb, GaussianSplats splats,
+                                            const std::vector<DrawOptions>& draw_options,
+                                            const std::vector<ScreenSplats>& screen_splats,
+                                            ComputeStorage compute_storage, gpu::Timer timer) {
+  auto N = splats->size();
+  auto view_count = static_cast<uint32_t>(draw_options.size());
+  if (view_count > ComputeStorageImpl::kMaxBatchViews) {
+    throw std::runtime_error("ComputeScreenSplatsBatch: at most " + std::to_string(ComputeStorageImpl::kMaxBatchViews) +
+                             " views per batch");
+  }
+  auto pair_count = view_count * N;
+  auto position_opacity = splats->position_opacity();
+  auto cov3d = splats->cov3d();
+  auto sh = splats->sh();
+  auto opacity_sh = splats->opacity_sh();
+
+  // Pairs of all views are sorted at once.
+  auto requirements = sorter_->GetStorageRequirements(pair_count);
+  compute_storage->Update(pair_count, requirements.usage, requirements.size);
+  compute_storage->UpdateBatch(pair_count);
+
+  auto key = compute_storage->key();
+  auto index = compute_storage->index();
+  auto sort_storage = compute_storage->sort_storage();
+  auto projection_dispatch = compute_storage->projection_dispatch();
+  auto camera = compute_storage->batch_camera();
+  auto projection_uniforms = compute_storage->batch_projection_uniforms();
+  auto visible_point_count = compute_storage->batch_visible_point_count();
+  auto draw_indirect = compute_storage->batch_draw_indirect();
+  auto instances = compute_storage->batch_instances();
+  auto stats = screen_splats[0]->stats();
+
+  const auto& options = draw_options[0];
+  ProjectionPushConstants projection_push_constants = {
+      .model = options.model,
+      .point_count = static_cast<uint32_t>(N),
+      .eps2d = options.eps2d,
+      .sh_degree_data = splats->sh_degree(),
+      .sh_degree_draw = options.sh_degree == -1 ? splats->sh_degree() : options.sh_degree,
+      .record_stat = false,
+      .opacity_degree = splats->opacity_degree(),
+      .front_to_back = false,
+      .view_count = view_count,
+  };
+
+  std::vector<glm::mat4> camera_data;
+  std::vector<ProjectionUniforms> projection_uniforms_data;
+  for (const auto& view_options : draw_options) {
+    camera_data.push_back(view_options.projection * view_options.view * view_options.model);
+    projection_uniforms_data.push_back(GetProjectionUniforms(view_options));
+  }
+
+  vkCmdUpdateBuffer(cb, camera, 0, view_count * sizeof(glm::mat4), camera_data.data());
+  vkCmdUpdateBuffer(cb, projection_uniforms, 0, view_count * sizeof(ProjectionUniforms),
+                    projection_uniforms_data.data());
+  vkCmdFillBuffer(cb, visible_point_count, 0, (1 + view_count) * sizeof(uint32_t), 0);
+
+  gpu::cmd::Barrier()
+      .Memory(VK_PIPELINE_STAGE_2_TRANSFER_BIT, VK_ACCESS_2_TRANSFER_WRITE_BIT, VK_PIPELINE_STAGE_2_COMPUTE_SHADER_BIT,
+              VK_ACCESS_2_SHADER_READ_BIT | VK_ACCESS_2_SHADER_WRITE_BIT | VK_ACCESS_2_UNIFORM_READ_BIT)
+      .Commit(cb);
+
+  // Rank, views in the y dimension
+  gpu::cmd::Pipeline pipeline(VK_PIPELINE_BIND_POINT_COMPUTE, compute_pipeline_layout_);
+  pipeline.Storage(0, camera)
+      .Storage(1, position_opacity)
+      .Storage(2, visible_point_count)
+      .Storage(3, key)
+      .Storage(4, index)
+      .PushConstant(VK_SHADER_STAGE_COMPUTE_BIT, 0, sizeof(projection_push_constants), &projection_push_constants)
+      .Bind(rank_batch_pipeline_)
+      .Commit(cb);
+  vkCmdDispatch(cb, WorkgroupSize(N, 256), view_count, 1);
+
+  // Sort by view, then depth. Total count is first in visible point count.
+  gpu::cmd::Barrier()
+      .Memory(VK_PIPELINE_STAGE_2_COMPUTE_SHADER_BIT, VK_ACCESS_2_SHADER_WRITE_BIT,
+              VK_PIPELINE_STAGE_2_COMPUTE_SHADER_BIT | VK_PIPELINE_STAGE_2_TRANSFER_BIT,
+              VK_ACCESS_2_SHADER_READ_BIT | VK_ACCESS_2_TRANSFER_READ_BIT)
+      .Commit(cb);
+
+  sorter_->SortKeyValueIndirect(cb, pair_count, visible_point_count, key, index, sort_storage);
+
+  // Draws of each view from its first instance, and projection dispatch over all pairs.
+  pipeline.Storage(0, visible_point_count)
+      .Storage(1, projection_dispatch)
+      .Storage(2, draw_indirect)
+      .Bind(indirect_batch_pipeline_)
+      .Commit(cb);
+  vkCmdDispatch(cb, 1, 1, 1);
+
+  gpu::cmd::Barrier()
+      .Memory(VK_PIPELINE_STAGE_2_COMPUTE_SHADER_BIT, VK_ACCESS_2_SHADER_WRITE_BIT,
+              VK_PIPELINE_STAGE_2_COMPUTE_SHADER_BIT | VK_PIPELINE_STAGE_2_DRAW_INDIRECT_BIT |
+                  VK_PIPELINE_STAGE_2_TRANSFER_BIT,
+              VK_ACCESS_2_SHADER_READ_BIT | VK_ACCESS_2_SHADER_WRITE_BIT | VK_ACCESS_2_INDIRECT_COMMAND_READ_BIT |
+                  VK_ACCESS_2_TRANSFER_READ_BIT)
+      .Commit(cb);
+
+  // Projection of all pairs, each with the camera of the view in its key.
+  auto projection_pipeline =
+      options.generic_projection
+          ? GetProjectionPipeline(kDynamicDegree, kDynamicDegree, false, true)
+          : GetProjectionPipeline(splats->sh_degree(), splats->opacity_degree(), false, true);
+  pipeline.Storage(1, position_opacity)
+      .Storage(2, cov3d)
+      .Storage(3, sh)
+      .Storage(4, opacity_sh)
+      .Storage(5, visible_point_count)
+      .Storage(6, index)
+      .Storage(7, key)
+      .Storage(8, instances)
+      .Storage(9, stats)
+      .Uniform(10, projection_uniforms)
+      .PushConstant(VK_SHADER_STAGE_COMPUTE_BIT, 0, sizeof(projection_push_constants), &projection_push_constants)
+      .Bind(projection_pipeline)
+      .Commit(cb);
+  vkCmdDispatchIndirect(cb, projection_dispatch, 0);
+
+  // Counts and draws to the screen splats of each view.
+  constexpr VkDeviceSize draw_indirect_size =
+      (1 + ScreenSplatsImpl::kDrawChunkCount) * sizeof(VkDrawIndexedIndirectCommand);
+  for (uint32_t i = 0; i < view_count; ++i) {
+    VkBufferCopy count_region = {(1 + i) * sizeof(uint32_t), 0, sizeof(uint32_t)};
+    vkCmdCopyBuffer(cb, visible_point_count, screen_splats[i]->visible_point_count(), 1, &count_region);
+    VkBufferCopy draw_region = {i * draw_indirect_size, 0, draw_indirect_size};
+    vkCmdCopyBuffer(cb, draw_indirect, screen_splats[i]->draw_indirect(), 1, &draw_region);
+  }
+
+  gpu::cmd::Barrier()
+      .Memory(VK_PIPELINE_STAGE_2_TRANSFER_BIT, VK_ACCESS_2_TRANSFER_WRITE_BIT, VK_PIPELINE_STAGE_2_COMPUTE_SHADER_BIT,
+              VK_ACCESS_2_SHADER_READ_BIT)
+      .Commit(cb);
+
+  // One compute timestamp for the pass shared by all views.
+  if (timer) {
+    timer->Record(cb, VK_PIPELINE_STAGE_2_COMPUTE_SHADER_BIT);
+  }
+
+  key->Keep();
+  index->Keep();
+  sort_storage->Keep();
+  projection_dispatch->Keep();
+  camera->Keep();
+  projection_uniforms->Keep();
+  visible_point_count->Keep();
+  draw_indirect->Keep();
+  instances->Keep();
+  stats->Keep();
+
+  for (uint32_t i = 0; i < view_count; ++i) {
+    screen_splats[i]->visible_point_count()->Keep();
+    screen_splats[i]->draw_indirect()->Keep();
+    screen_splats[i]->SetInstances(instances);
+    screen_splats[i]->SetIndexBuffer(splats->index_buffer());
+    screen_splats[i]->SetProjection(draw_options[i].projection);
+  }
+}
+
+void RendererImpl::RenderScreenSplatsColor(VkCommandBuffer cb, ScreenSplats screen_splats,
+                                           const ScreenSplatOptions& screen_splat_options,
+                                           const RenderTargetOptions& render_target_options) {
+  bool depth_outputs = render_target_options.depth_outputs;
+  auto splat_color_pipeline = gpu::GraphicsPipeline::Create({
       .pipeline_layout = graphics_pipeline_layout_,
-      .vertex_shader = gpu::ShaderCode(splat_color_vert),
-      .fragment_shader = gpu::ShaderCode(splat_color_frag),
+      .vertex_shader = depth_outputs ? gpu::ShaderCode(splat_depth_outputs_vert) : gpu::ShaderCode(splat_color_vert),
+      .fragment_shader = depth_outputs ? gpu::ShaderCode(splat_depth_outputs_frag) : gpu::ShaderCode(splat_color_frag),
       .formats = render_target_options.formats,
       .locations = render_target_options.locations,
       .depth_format = render_target_options.depth_format,
@@ -428,6 +1943,7 @@ void RendererImpl::RenderScreenSplatsColor(VkCommandBuffer cb, ScreenSplats scre
   });
 
   SplatPushConstants splat_push_constants = {
+      .projection_inverse = glm::inverse(screen_splats->projection()),
       .confidence_radius = screen_splat_options.confidence_radius,
   };
   gpu::cmd::Pipeline(VK_PIPELINE_BIND_POINT_GRAPHICS, graphics_pipeline_layout_)
@@ -477,5 +1993,572 @@ void RendererImpl::RenderScreenSplatsDepth(VkCommandBuffer cb, ScreenSplats scre
   screen_splats->draw_indirect()->Keep();
 }
 
+void RendererImpl::RenderScreenSplatsFrontToBack(VkCommandBuffer cb, ScreenSplats screen_splats,
+                                                 const DrawOptions& draw_options,
+                                                 const ScreenSplatOptions& screen_splat_options,
+                                                 GraphicsStorage graphics_storage,
+                                                 gpu::PipelineStatistics fragment_statistics) {
+  uint32_t width = draw_options.width;
+  uint32_t height = draw_options.height;
+  auto image = graphics_storage->image();
+  auto depth = graphics_storage->depth();
+  auto draw_indirect = screen_splats->draw_indirect();
+
+  // Splats under the pixels drawn so far. Depth test rejects fragments of saturated pixels, marked with the depth of
+  // the last splat drawn when they saturated.
+  auto splat_pipeline = gpu::GraphicsPipeline::Create({
+      .pipeline_layout = graphics_pipeline_layout_,
+      .vertex_shader = gpu::ShaderCode(splat_color_vert),
+      .fragment_shader = gpu::ShaderCode(splat_color_frag),
+      .formats = {image->format()},
+      .locations = {0},
+      .depth_format = depth->format(),
+      .depth_test = true,
+      .depth_write = false,
+      .blend_mode = gpu::BlendMode::UNDER,
+  });
+  auto saturate_pipeline = gpu::GraphicsPipeline::Create({
+      .pipeline_layout = screen_pipeline_layout_,
+      .vertex_shader = gpu::ShaderCode(saturate_vert),
+      .fragment_shader = gpu::ShaderCode(saturate_frag),
+      .formats = {image->format()},
+      .locations = {VK_ATTACHMENT_UNUSED},
+      .input_indices = {0},
+      .depth_format = depth->format(),
+      .depth_test = true,
+      .depth_write = true,
+  });
+  auto background_pipeline = gpu::GraphicsPipeline::Create({
+      .pipeline_layout = screen_pipeline_layout_,
+      .vertex_shader = gpu::ShaderCode(screen_vert),
+      .fragment_shader = gpu::ShaderCode(background_frag),
+      .formats = {image->format()},
+      .locations = {0},
+      .depth_format = depth->format(),
+      .depth_test = false,
+      .depth_write = false,
+      .blend_mode = gpu::BlendMode::UNDER,
+  });
+
+  // Layout transition to attachments. Previous frame in this slot may still test or copy depth.
+  gpu::cmd::Barrier()
+      .Image(0, 0, VK_PIPELINE_STAGE_2_COLOR_ATTACHMENT_OUTPUT_BIT, VK_ACCESS_2_COLOR_ATTACHMENT_WRITE_BIT,
+             VK_IMAGE_LAYOUT_UNDEFINED, VK_IMAGE_LAYOUT_RENDERING_LOCAL_READ, image)
+      .Image(VK_PIPELINE_STAGE_2_EARLY_FRAGMENT_TESTS_BIT | VK_PIPELINE_STAGE_2_LATE_FRAGMENT_TESTS_BIT |
+                 VK_PIPELINE_STAGE_2_TRANSFER_BIT,
+             0,
+             VK_PIPELINE_STAGE_2_EARLY_FRAGMENT_TESTS_BIT | VK_PIPELINE_STAGE_2_LATE_FRAGMENT_TESTS_BIT,
+             VK_ACCESS_2_DEPTH_STENCIL_ATTACHMENT_READ_BIT | VK_ACCESS_2_DEPTH_STENCIL_ATTACHMENT_WRITE_BIT,
+             VK_IMAGE_LAYOUT_UNDEFINED, VK_IMAGE_LAYOUT_DEPTH_ATTACHMENT_OPTIMAL, depth)
+      .Commit(cb);
+
+  // Rendering
+  VkRenderingAttachmentInfo color_attachment = {
+      .sType = VK_STRUCTURE_TYPE_RENDERING_ATTACHMENT_INFO,
+      .imageView = image->image_view(),
+      .imageLayout = VK_IMAGE_LAYOUT_RENDERING_LOCAL_READ,
+      .loadOp = VK_ATTACHMENT_LOAD_OP_CLEAR,
+      .storeOp = VK_ATTACHMENT_STORE_OP_STORE,
+      .clearValue = {0.f, 0.f, 0.f, 0.f},
+  };
+  VkRenderingAttachmentInfo depth_attachment = {
+      .sType = VK_STRUCTURE_TYPE_RENDERING_ATTACHMENT_INFO,
+      .imageView = depth->image_view(),
+      .imageLayout = VK_IMAGE_LAYOUT_DEPTH_ATTACHMENT_OPTIMAL,
+      .loadOp = VK_ATTACHMENT_LOAD_OP_CLEAR,
+      .storeOp = VK_ATTACHMENT_STORE_OP_STORE,  // Depth pyramid input.
+      .clearValue = {.depthStencil = {1.f, 0}},
+  };
+  VkRenderingInfo rendering_info = {
+      .sType = VK_STRUCTURE_TYPE_RENDERING_INFO,
+      .renderArea = {{0, 0}, {width, height}},
+      .layerCount = 1,
+      .colorAttachmentCount = 1,
+      .pColorAttachments = &color_attachment,
+      .pDepthAttachment = &depth_attachment,
+  };
+  vkCmdBeginRendering(cb, &rendering_info);
+
+  VkViewport viewport = {0.f, 0.f, static_cast<float>(width), static_cast<float>(height), 0.f, 1.f};
+  vkCmdSetViewport(cb, 0, 1, &viewport);
+  VkRect2D scissor = {0, 0, width, height};
+  vkCmdSetScissor(cb, 0, 1, &scissor);
+
+  SplatPushConstants splat_push_constants = {
+      .confidence_radius = screen_splat_options.confidence_radius,
+  };
+  ScreenPushConstants screen_push_constants = {
+      .background = glm::vec4(draw_options.background, 0.f),
+      .saturation_alpha = kSaturationAlpha,
+  };
+
+  vkCmdBindIndexBuffer(cb, screen_splats->index_buffer(), 0, VK_INDEX_TYPE_UINT32);
+  for (uint32_t i = 0; i < ScreenSplatsImpl::kDrawChunkCount; ++i) {
+    // Splat layout is not compatible with the screen layout, so push again after saturation.
+    gpu::cmd::Pipeline(VK_PIPELINE_BIND_POINT_GRAPHICS, graphics_pipeline_layout_)
+        .PushConstant(VK_SHADER_STAGE_VERTEX_BIT, 0, sizeof(splat_push_constants), &splat_push_constants)
+        .Storage(0, screen_splats->instances())
+        .Bind(splat_pipeline)
+        .AttachmentLocations({0})
+        .Commit(cb);
+
+    if (fragment_statistics) fragment_statistics->Begin(cb);
+    vkCmdDrawIndexedIndirect(cb, draw_indirect, (1 + i) * sizeof(VkDrawIndexedIndirectCommand), 1, 0);
+    if (fragment_statistics) fragment_statistics->End(cb);
+
+    if (i + 1 == ScreenSplatsImpl::kDrawChunkCount) break;
+
+    screen_push_constants.chunk = i;
+
+    // Mark saturated pixels. Color is read as input attachment, and written again by the next chunk.
+    gpu::cmd::Barrier(VK_DEPENDENCY_BY_REGION_BIT)
+        .Memory(VK_PIPELINE_STAGE_2_COLOR_ATTACHMENT_OUTPUT_BIT, VK_ACCESS_2_COLOR_ATTACHMENT_WRITE_BIT,
+                VK_PIPELINE_STAGE_2_FRAGMENT_SHADER_BIT, VK_ACCESS_2_INPUT_ATTACHMENT_READ_BIT)
+        .Commit(cb);
+
+    gpu::cmd::Pipeline(VK_PIPELINE_BIND_POINT_GRAPHICS, screen_pipeline_layout_)
+        .Input(0, image->image_view(), VK_IMAGE_LAYOUT_RENDERING_LOCAL_READ)
+        .Storage(1, screen_splats->instances())
+        .Storage(2, draw_indirect)
+        .PushConstant(VK_SHADER_STAGE_VERTEX_BIT | VK_SHADER_STAGE_FRAGMENT_BIT, 0, sizeof(screen_push_constants),
+                      &screen_push_constants)
+        .Bind(saturate_pipeline)
+        .AttachmentLocations({VK_ATTACHMENT_UNUSED})
+        .Commit(cb);
+    vkCmdDraw(cb, 3, 1, 0, 0);
+
+    gpu::cmd::Barrier(VK_DEPENDENCY_BY_REGION_BIT)
+        .Memory(VK_PIPELINE_STAGE_2_FRAGMENT_SHADER_BIT, 0, VK_PIPELINE_STAGE_2_COLOR_ATTACHMENT_OUTPUT_BIT,
+                VK_ACCESS_2_COLOR_ATTACHMENT_WRITE_BIT)
+        .Commit(cb);
+  }
+
+  // Background under all splats.
+  gpu::cmd::Pipeline(VK_PIPELINE_BIND_POINT_GRAPHICS, screen_pipeline_layout_)
+      .PushConstant(VK_SHADER_STAGE_VERTEX_BIT | VK_SHADER_STAGE_FRAGMENT_BIT, 0, sizeof(screen_push_constants),
+                    &screen_push_constants)
+      .Bind(background_pipeline)
+      .Commit(cb);
+  vkCmdDraw(cb, 3, 1, 0, 0);
+
+  vkCmdEndRendering(cb);
+
+  splat_pipeline->Keep();
+  saturate_pipeline->Keep();
+  background_pipeline->Keep();
+  image->Keep();
+  depth->Keep();
+  screen_splats->index_buffer()->Keep();
+  screen_splats->instances()->Keep();
+  draw_indirect->Keep();
+}
+
+void RendererImpl::RenderScreenSplatsOit(VkCommandBuffer cb, ScreenSplats screen_splats,
+                                         const DrawOptions& draw_options,
+                                         const ScreenSplatOptions& screen_splat_options,
+                                         GraphicsStorage graphics_storage,
+                                         gpu::PipelineStatistics fragment_statistics) {
+  uint32_t width = draw_options.width;
+  uint32_t height = draw_options.height;
+  auto image = graphics_storage->image();
+  auto accum = graphics_storage->oit_accum();
+  auto revealage = graphics_storage->oit_revealage();
+  std::vector<VkFormat> formats = {image->format(), accum->format(), revealage->format()};
+
+  auto splat_pipeline = gpu::GraphicsPipeline::Create({
+      .pipeline_layout = graphics_pipeline_layout_,
+      .vertex_shader = gpu::ShaderCode(splat_oit_vert),
+      .fragment_shader = gpu::ShaderCode(splat_oit_frag),
+      .formats = formats,
+      .locations = {VK_ATTACHMENT_UNUSED, 0, 1},
+      .blend_mode = gpu::BlendMode::ADD,
+  });
+  auto resolve_pipeline = gpu::GraphicsPipeline::Create({
+      .pipeline_layout = screen_pipeline_layout_,
+      .vertex_shader = gpu::ShaderCode(screen_vert),
+      .fragment_shader = gpu::ShaderCode(oit_resolve_frag),
+      .formats = formats,
+      .locations = {0, VK_ATTACHMENT_UNUSED, VK_ATTACHMENT_UNUSED},
+      .input_indices = {VK_ATTACHMENT_UNUSED, 0, 1},
+  });
+
+  // Layout transition to attachments. Previous frame in this slot may still read accumulation targets.
+  gpu::cmd::Barrier()
+      .Image(0, 0, VK_PIPELINE_STAGE_2_COLOR_ATTACHMENT_OUTPUT_BIT, VK_ACCESS_2_COLOR_ATTACHMENT_WRITE_BIT,
+             VK_IMAGE_LAYOUT_UNDEFINED, VK_IMAGE_LAYOUT_RENDERING_LOCAL_READ, image)
+      .Image(VK_PIPELINE_STAGE_2_FRAGMENT_SHADER_BIT, 0, VK_PIPELINE_STAGE_2_COLOR_ATTACHMENT_OUTPUT_BIT,
+             VK_ACCESS_2_COLOR_ATTACHMENT_READ_BIT | VK_ACCESS_2_COLOR_ATTACHMENT_WRITE_BIT, VK_IMAGE_LAYOUT_UNDEFINED,
+             VK_IMAGE_LAYOUT_RENDERING_LOCAL_READ, accum)
+      .Image(VK_PIPELINE_STAGE_2_FRAGMENT_SHADER_BIT, 0, VK_PIPELINE_STAGE_2_COLOR_ATTACHMENT_OUTPUT_BIT,
+             VK_ACCESS_2_COLOR_ATTACHMENT_READ_BIT | VK_ACCESS_2_COLOR_ATTACHMENT_WRITE_BIT, VK_IMAGE_LAYOUT_UNDEFINED,
+             VK_IMAGE_LAYOUT_RENDERING_LOCAL_READ, revealage)
+      .Commit(cb);
+
+  // Rendering
+  std::vector<VkRenderingAttachmentInfo> color_attachments = {
+      {
+          .sType = VK_STRUCTURE_TYPE_RENDERING_ATTACHMENT_INFO,
+          .imageView = image->image_view(),
+          .imageLayout = VK_IMAGE_LAYOUT_RENDERING_LOCAL_READ,
+          .loadOp = VK_ATTACHMENT_LOAD_OP_CLEAR,
+          .storeOp = VK_ATTACHMENT_STORE_OP_STORE,
+          .clearValue = {draw_options.background.r, draw_options.background.g, draw_options.background.b, 0.f},
+      },
+      {
+          .sType = VK_STRUCTURE_TYPE_RENDERING_ATTACHMENT_INFO,
+          .imageView = accum->image_view(),
+          .imageLayout = VK_IMAGE_LAYOUT_RENDERING_LOCAL_READ,
+          .loadOp = VK_ATTACHMENT_LOAD_OP_CLEAR,
+          .storeOp = VK_ATTACHMENT_STORE_OP_DONT_CARE,
+          .clearValue = {0.f, 0.f, 0.f, 0.f},
+      },
+      {
+          .sType = VK_STRUCTURE_TYPE_RENDERING_ATTACHMENT_INFO,
+          .imageView = revealage->image_view(),
+          .imageLayout = VK_IMAGE_LAYOUT_RENDERING_LOCAL_READ,
+          .loadOp = VK_ATTACHMENT_LOAD_OP_CLEAR,
+          .storeOp = VK_ATTACHMENT_STORE_OP_DONT_CARE,
+          .clearValue = {0.f, 0.f, 0.f, 0.f},
+      },
+  };
+  VkRenderingInfo rendering_info = {
+      .sType = VK_STRUCTURE_TYPE_RENDERING_INFO,
+      .renderArea = {{0, 0}, {width, height}},
+      .layerCount = 1,
+      .colorAttachmentCount = static_cast<uint32_t>(color_attachments.size()),
+      .pColorAttachments = color_attachments.data(),
+  };
+  vkCmdBeginRendering(cb, &rendering_info);
+
+  VkViewport viewport = {0.f, 0.f, static_cast<float>(width), static_cast<float>(height), 0.f, 1.f};
+  vkCmdSetViewport(cb, 0, 1, &viewport);
+  VkRect2D scissor = {0, 0, width, height};
+  vkCmdSetScissor(cb, 0, 1, &scissor);
+
+  // Accumulate
+  SplatPushConstants splat_push_constants = {
+      .projection_inverse = glm::inverse(screen_splats->projection()),
+      .confidence_radius = screen_splat_options.confidence_radius,
+  };
+  gpu::cmd::Pipeline(VK_PIPELINE_BIND_POINT_GRAPHICS, graphics_pipeline_layout_)
+      .PushConstant(VK_SHADER_STAGE_VERTEX_BIT, 0, sizeof(splat_push_constants), &splat_push_constants)
+      .Storage(0, screen_splats->instances())
+      .Bind(splat_pipeline)
+      .AttachmentLocations({VK_ATTACHMENT_UNUSED, 0, 1})
+      .Commit(cb);
+
+  vkCmdBindIndexBuffer(cb, screen_splats->index_buffer(), 0, VK_INDEX_TYPE_UINT32);
+  if (fragment_statistics) fragment_statistics->Begin(cb);
+  vkCmdDrawIndexedIndirect(cb, screen_splats->draw_indirect(), 0, 1, 0);
+  if (fragment_statistics) fragment_statistics->End(cb);
+
+  // Resolve over background
+  gpu::cmd::Barrier(VK_DEPENDENCY_BY_REGION_BIT)
+      .Memory(VK_PIPELINE_STAGE_2_COLOR_ATTACHMENT_OUTPUT_BIT, VK_ACCESS_2_COLOR_ATTACHMENT_WRITE_BIT,
+              VK_PIPELINE_STAGE_2_FRAGMENT_SHADER_BIT, VK_ACCESS_2_INPUT_ATTACHMENT_READ_BIT)
+      .Commit(cb);
+
+  gpu::cmd::Pipeline(VK_PIPELINE_BIND_POINT_GRAPHICS, screen_pipeline_layout_)
+      .Input(0, accum->image_view(), VK_IMAGE_LAYOUT_RENDERING_LOCAL_READ)
+      .Input(3, revealage->image_view(), VK_IMAGE_LAYOUT_RENDERING_LOCAL_READ)
+      .Bind(resolve_pipeline)
+      .AttachmentLocations({0, VK_ATTACHMENT_UNUSED, VK_ATTACHMENT_UNUSED})
+      .InputAttachmentIndices({VK_ATTACHMENT_UNUSED, 0, 1})
+      .Commit(cb);
+  vkCmdDraw(cb, 3, 1, 0, 0);
+
+  vkCmdEndRendering(cb);
+
+  splat_pipeline->Keep();
+  resolve_pipeline->Keep();
+  image->Keep();
+  accum->Keep();
+  revealage->Keep();
+  screen_splats->index_buffer()->Keep();
+  screen_splats->instances()->Keep();
+  screen_splats->draw_indirect()->Keep();
+}
+
+void RendererImpl::RasterizeScreenSplatsTile(VkCommandBuffer cb, ScreenSplats screen_splats, size_t point_count,
+                                             const DrawOptions& draw_options,
+                                             const ScreenSplatOptions& screen_splat_options,
+                                             GraphicsStorage graphics_storage, gpu::Buffer tile_pair_count) {
+  auto N = point_count;
+  // In 64 bits, as points times pairs per point overflow 32 bits from 512M points.
+  uint64_t demand = std::max<uint64_t>(static_cast<uint64_t>(N) * kTilePairsPerPoint, tile_pair_demand_->load());
+  auto tile_capacity = static_cast<uint32_t>(std::min(demand, kMaxTilePairCapacity));
+  auto requirements = tile_sorter_->GetStorageRequirements(tile_capacity);
+  graphics_storage->UpdateTiles(N, tile_capacity, requirements.usage, requirements.size);
+
+  auto visible_point_count = screen_splats->visible_point_count();
+  auto instances = screen_splats->instances();
+  auto image = graphics_storage->image();
+  auto tile_splat_count = graphics_storage->tile_splat_count();
+  auto tile_dispatch = graphics_storage->tile_dispatch();
+  auto tile_ranges = graphics_storage->tile_ranges();
+  auto tile_keys = graphics_storage->tile_keys();
+  auto tile_values = graphics_storage->tile_values();
+  auto tile_sort_storage = graphics_storage->tile_sort_storage();
+  auto tile_workgroup_offset = graphics_storage->tile_workgroup_offset();
+
+  glm::uvec2 tile_grid(WorkgroupSize(draw_options.width, GraphicsStorageImpl::kTileSize),
+                       WorkgroupSize(draw_options.height, GraphicsStorageImpl::kTileSize));
+  TilePushConstants tile_push_constants = {
+      .background = glm::vec4(draw_options.background, 0.f),
+      .screen_size = {draw_options.width, draw_options.height},
+      .tile_count = tile_grid,
+      .point_count = static_cast<uint32_t>(N),
+      .tile_capacity = tile_capacity,
+      .confidence_radius = screen_splat_options.confidence_radius,
+      .projection_inverse = glm::inverse(screen_splats->projection()),
+  };
+
+  // Previous frame in this slot may still read tile buffers, or copy tile pair counts.
+  gpu::cmd::Barrier()
+      .Memory(VK_PIPELINE_STAGE_2_COMPUTE_SHADER_BIT | VK_PIPELINE_STAGE_2_COPY_BIT, 0,
+              VK_PIPELINE_STAGE_2_TRANSFER_BIT | VK_PIPELINE_STAGE_2_COMPUTE_SHADER_BIT, 0)
+      .Commit(cb);
+  vkCmdFillBuffer(cb, tile_ranges, 0, tile_ranges->size(), 0);
+
+  // Tile-splat pair counts, and their scan
+  gpu::cmd::Pipeline pipeline(VK_PIPELINE_BIND_POINT_COMPUTE, tile_pipeline_layout_);
+  pipeline.Storage(0, visible_point_count)
+      .Storage(1, instances)
+      .Storage(2, tile_splat_count)
+      .Storage(3, tile_keys)
+      .Storage(4, tile_values)
+      .Storage(5, tile_workgroup_offset)
+      .Storage(6, tile_ranges)
+      .StorageImage(7, image->image_view(), VK_IMAGE_LAYOUT_GENERAL)
+      .Storage(8, tile_dispatch)
+      .PushConstant(VK_SHADER_STAGE_COMPUTE_BIT, 0, sizeof(tile_push_constants), &tile_push_constants)
+      .Bind(tile_count_pipeline_)
+      .Commit(cb);
+  vkCmdDispatch(cb, WorkgroupSize(N, 256), 1, 1);
+
+  gpu::cmd::Barrier()
+      .Memory(VK_PIPELINE_STAGE_2_COMPUTE_SHADER_BIT, VK_ACCESS_2_SHADER_WRITE_BIT,
+              VK_PIPELINE_STAGE_2_COMPUTE_SHADER_BIT, VK_ACCESS_2_SHADER_READ_BIT | VK_ACCESS_2_SHADER_WRITE_BIT)
+      .Commit(cb);
+
+  pipeline.Bind(tile_scan_pipeline_).Commit(cb);
+  vkCmdDispatch(cb, 1, 1, 1);
+
+  // Emit pairs in rank order
+  gpu::cmd::Barrier()
+      .Memory(VK_PIPELINE_STAGE_2_COMPUTE_SHADER_BIT, VK_ACCESS_2_SHADER_WRITE_BIT,
+              VK_PIPELINE_STAGE_2_COMPUTE_SHADER_BIT, VK_ACCESS_2_SHADER_READ_BIT)
+      .Commit(cb);
+
+  pipeline.Bind(tile_emit_pipeline_).Commit(cb);
+  vkCmdDispatch(cb, WorkgroupSize(N, 256), 1, 1);
+
+  // Stable sort by tile id. Pairs are emitted in rank order, i.e. back-to-front, so sorting 32-bit tile ids stably gives
+  // the order of 64-bit (tile id, depth) keys, which the radix sorter does not support, in half the key bandwidth.
+  gpu::cmd::Barrier()
+      .Memory(VK_PIPELINE_STAGE_2_COMPUTE_SHADER_BIT, VK_ACCESS_2_SHADER_WRITE_BIT,
+              VK_PIPELINE_STAGE_2_COMPUTE_SHADER_BIT | VK_PIPELINE_STAGE_2_TRANSFER_BIT,
+              VK_ACCESS_2_SHADER_READ_BIT | VK_ACCESS_2_TRANSFER_READ_BIT)
+      .Commit(cb);
+
+  tile_sorter_->SortKeyValueIndirect(cb, tile_capacity, tile_splat_count, tile_keys, tile_values, tile_sort_storage);
+
+  // Tile ranges
+  gpu::cmd::Barrier()
+      .Memory(VK_PIPELINE_STAGE_2_COMPUTE_SHADER_BIT | VK_PIPELINE_STAGE_2_TRANSFER_BIT,
+              VK_ACCESS_2_SHADER_WRITE_BIT | VK_ACCESS_2_TRANSFER_WRITE_BIT,
+              VK_PIPELINE_STAGE_2_COMPUTE_SHADER_BIT | VK_PIPELINE_STAGE_2_DRAW_INDIRECT_BIT,
+              VK_ACCESS_2_SHADER_READ_BIT | VK_ACCESS_2_SHADER_WRITE_BIT | VK_ACCESS_2_INDIRECT_COMMAND_READ_BIT)
+      .Commit(cb);
+
+  // Sorter binds its own layout, so push all descriptors again.
+  pipeline.Storage(0, visible_point_count)
+      .Storage(1, instances)
+      .Storage(2, tile_splat_count)
+      .Storage(3, tile_keys)
+      .Storage(4, tile_values)
+      .Storage(5, tile_workgroup_offset)
+      .Storage(6, tile_ranges)
+      .StorageImage(7, image->image_view(), VK_IMAGE_LAYOUT_GENERAL)
+      .Storage(8, tile_dispatch)
+      .PushConstant(VK_SHADER_STAGE_COMPUTE_BIT, 0, sizeof(tile_push_constants), &tile_push_constants)
+      .Bind(tile_range_pipeline_)
+      .Commit(cb);
+  vkCmdDispatchIndirect(cb, tile_dispatch, 0);
+
+  // Rasterize
+  gpu::cmd::Barrier barrier;
+  barrier
+      .Memory(VK_PIPELINE_STAGE_2_COMPUTE_SHADER_BIT, VK_ACCESS_2_SHADER_WRITE_BIT,
+              VK_PIPELINE_STAGE_2_COMPUTE_SHADER_BIT, VK_ACCESS_2_SHADER_READ_BIT)
+      .Image(VK_PIPELINE_STAGE_2_BLIT_BIT, 0, VK_PIPELINE_STAGE_2_COMPUTE_SHADER_BIT, VK_ACCESS_2_SHADER_WRITE_BIT,
+             VK_IMAGE_LAYOUT_UNDEFINED, VK_IMAGE_LAYOUT_GENERAL, image);
+  if (draw_options.output_depth) {
+    auto depth_outputs = graphics_storage->depth_outputs();
+    barrier.Image(VK_PIPELINE_STAGE_2_COPY_BIT, 0, VK_PIPELINE_STAGE_2_COMPUTE_SHADER_BIT,
+                  VK_ACCESS_2_SHADER_WRITE_BIT, VK_IMAGE_LAYOUT_UNDEFINED, VK_IMAGE_LAYOUT_GENERAL, depth_outputs);
+    pipeline.StorageImage(9, depth_outputs->image_view(), VK_IMAGE_LAYOUT_GENERAL)
+        .Bind(tile_raster_depth_outputs_pipeline_);
+    depth_outputs->Keep();
+  } else {
+    pipeline.Bind(tile_raster_pipeline_);
+  }
+  barrier.Commit(cb);
+
+  pipeline.Commit(cb);
+  vkCmdDispatch(cb, tile_grid.x, tile_grid.y, 1);
+
+  if (tile_pair_count) {
+    gpu::cmd::Barrier()
+        .Memory(VK_PIPELINE_STAGE_2_COMPUTE_SHADER_BIT, VK_ACCESS_2_SHADER_WRITE_BIT, VK_PIPELINE_STAGE_2_COPY_BIT,
+                VK_ACCESS_2_TRANSFER_READ_BIT)
+        .Commit(cb);
+
+    VkBufferCopy region = {0, 0, 2 * sizeof(uint32_t)};
+    vkCmdCopyBuffer(cb, tile_splat_count, tile_pair_count, 1, &region);
+
+    gpu::cmd::Barrier()
+        .Memory(VK_PIPELINE_STAGE_2_COPY_BIT, VK_ACCESS_2_TRANSFER_WRITE_BIT, VK_PIPELINE_STAGE_2_HOST_BIT,
+                VK_ACCESS_2_HOST_READ_BIT)
+        .Commit(cb);
+
+    tile_pair_count->Keep();
+  }
+
+  visible_point_count->Keep();
+  instances->Keep();
+  image->Keep();
+  tile_splat_count->Keep();
+  tile_dispatch->Keep();
+  tile_ranges->Keep();
+  tile_keys->Keep();
+  tile_values->Keep();
+  tile_sort_storage->Keep();
+  tile_workgroup_offset->Keep();
+}
+
+RendererImpl::Readback RendererImpl::GetReadback(uint8_t* dst, VkDeviceSize size, VkDeviceSize texel_size,
+                                                 ReadbackPool& pool) {
+  // Written by image copies, or by the output conversion pass.
+  VkBufferUsageFlags usage = VK_BUFFER_USAGE_TRANSFER_DST_BIT | VK_BUFFER_USAGE_STORAGE_BUFFER_BIT;
+
+  // Import the pages spanning dst, and copy at the offset of dst. Copy offsets must be multiples of the texel size.
+  // The output conversion pass writes whole words, merging partially covered words at the ends, so dst must also
+  // end at a texel boundary, or bytes next to dst would be written back by the GPU.
+  auto alignment = gpu::GetDevice()->min_imported_host_pointer_alignment();
+  auto address = reinterpret_cast<uintptr_t>(dst);
+  if (dst && alignment > 0 && address % texel_size == 0 && size % texel_size == 0) {
+    uintptr_t begin = address / alignment * alignment;
+    uintptr_t end = (address + size + alignment - 1) / alignment * alignment;
+    auto buffer = gpu::Buffer::Create(usage, end - begin, reinterpret_cast<void*>(begin));
+    if (buffer->data()) return {buffer, address - begin, true};
+  }
+
+  // Rounded up to whole words for the output conversion pass.
+  VkDeviceSize buffer_size = (size + 3) / 4 * 4;
+
+  // The host copy of the previous submission must be done before a pooled buffer is overwritten. Rather than waiting
+  // for the GPU here, while callers may hold a lock, a buffer still in use is skipped.
+  for (size_t i = 0; i < pool.buffers.size(); ++i) {
+    if (!pool.tasks[i] || !pool.tasks[i]->IsDone()) continue;
+    pool.tasks[i] = {};
+    if (pool.buffers[i]->size() < size) pool.buffers[i] = gpu::Buffer::Create(usage, buffer_size, true);
+    return {pool.buffers[i], 0, false, static_cast<int>(i)};
+  }
+
+  // All in use. Freed with its submission once the pool is full.
+  auto buffer = gpu::Buffer::Create(usage, buffer_size, true);
+  if (pool.buffers.size() >= ReadbackPool::kMaxBufferCount) return {buffer, 0, false};
+  pool.buffers.push_back(buffer);
+  pool.tasks.push_back({});
+  return {buffer, 0, false, static_cast<int>(pool.buffers.size() - 1)};
+}
+
+void RendererImpl::KeepReadback(const Readback& readback, ReadbackPool& pool, gpu::QueueTask task) {
+  if (readback.pool_index >= 0) pool.tasks[readback.pool_index] = task;
+}
+
+gpu::ComputePipeline RendererImpl::GetProjectionPipeline(int sh_degree, int opacity_degree, bool color_cache,
+                                                         bool batch) {
+  auto key = std::make_tuple(sh_degree, opacity_degree, color_cache, batch);
+  auto it = projection_pipelines_.find(key);
+  if (it != projection_pipelines_.end()) return it->second;
+
+  std::vector<uint32_t> specialization_constants = {static_cast<uint32_t>(sh_degree),
+                                                    static_cast<uint32_t>(opacity_degree), color_cache};
+  gpu::ComputePipeline pipeline;
+  if (batch) {
+    pipeline = gpu::ComputePipeline::Create(compute_pipeline_layout_, projection_batch, specialization_constants);
+  } else {
+    pipeline = gpu::ComputePipeline::Create(compute_pipeline_layout_, projection, specialization_constants);
+  }
+  projection_pipelines_[key] = pipeline;
+  return pipeline;
+}
+
+void RendererImpl::BuildHiz(VkCommandBuffer cb, GraphicsStorage graphics_storage) {
+  auto depth = graphics_storage->depth();
+  auto hiz_depth = graphics_storage->hiz_depth();
+  auto hiz = graphics_storage->hiz();
+  auto screen_size = graphics_storage->hiz_screen_size();
+
+  // Depth to buffer. Previous frame in this slot may still read the pyramid in compute queue, ordered by semaphores.
+  gpu::cmd::Barrier()
+      .Image(VK_PIPELINE_STAGE_2_EARLY_FRAGMENT_TESTS_BIT | VK_PIPELINE_STAGE_2_LATE_FRAGMENT_TESTS_BIT,
+             VK_ACCESS_2_DEPTH_STENCIL_ATTACHMENT_WRITE_BIT, VK_PIPELINE_STAGE_2_TRANSFER_BIT,
+             VK_ACCESS_2_TRANSFER_READ_BIT, VK_IMAGE_LAYOUT_DEPTH_ATTACHMENT_OPTIMAL,
+             VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL, depth)
+      .Commit(cb);
+
+  VkBufferImageCopy region = {
+      .bufferOffset = 0,
+      .bufferRowLength = 0,
+      .bufferImageHeight = 0,
+      .imageSubresource = {VK_IMAGE_ASPECT_DEPTH_BIT, 0, 0, 1},
+      .imageOffset = {0, 0, 0},
+      .imageExtent = {screen_size.x, screen_size.y, 1},
+  };
+  vkCmdCopyImageToBuffer(cb, depth, VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL, hiz_depth, 1, &region);
+
+  gpu::cmd::Barrier()
+      .Memory(VK_PIPELINE_STAGE_2_TRANSFER_BIT, VK_ACCESS_2_TRANSFER_WRITE_BIT, VK_PIPELINE_STAGE_2_COMPUTE_SHADER_BIT,
+              VK_ACCESS_2_SHADER_READ_BIT)
+      .Commit(cb);
+
+  // Levels, each from the level below.
+  gpu::cmd::Pipeline pipeline(VK_PIPELINE_BIND_POINT_COMPUTE, hiz_pipeline_layout_);
+  pipeline.Storage(0, hiz_depth).Storage(1, hiz).Bind(hiz_pipeline_).Commit(cb);
+
+  HizPushConstants hiz_push_constants = {
+      .src_size = screen_size,
+      .dst_size = (screen_size + 1u) / 2u,
+      .src_offset = 0,
+      .dst_offset = 0,
+      .level = 0,
+  };
+  for (uint32_t level = 0; level < graphics_storage->hiz_level_count(); ++level) {
+    if (level > 0) {
+      gpu::cmd::Barrier()
+          .Memory(VK_PIPELINE_STAGE_2_COMPUTE_SHADER_BIT, VK_ACCESS_2_SHADER_WRITE_BIT,
+                  VK_PIPELINE_STAGE_2_COMPUTE_SHADER_BIT, VK_ACCESS_2_SHADER_READ_BIT | VK_ACCESS_2_SHADER_WRITE_BIT)
+          .Commit(cb);
+    }
+
+    pipeline.PushConstant(VK_SHADER_STAGE_COMPUTE_BIT, 0, sizeof(hiz_push_constants), &hiz_push_constants).Commit(cb);
+    auto dst_size = hiz_push_constants.dst_size;
+    vkCmdDispatch(cb, WorkgroupSize(dst_size.x, 16), WorkgroupSize(dst_size.y, 16), 1);
+
+    hiz_push_constants.src_size = hiz_push_constants.dst_size;
+    hiz_push_constants.src_offset = hiz_push_constants.dst_offset;
+    hiz_push_constants.dst_offset += hiz_push_constants.dst_size.x * hiz_push_constants.dst_size.y;
+    hiz_push_constants.dst_size = (hiz_push_constants.dst_size + 1u) / 2u;
+    hiz_push_constants.level = level + 1;
+  }
+
+  depth->Keep();
+  hiz_depth->Keep();
+  hiz->Keep();
+}
+
 }  // namespace core
 }  // namespace vkgs
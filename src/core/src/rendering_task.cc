@@ -14,5 +14,11 @@ void RenderingTaskImpl::Wait() {
   }
 }
 
+void RenderingTaskImpl::WaitFence() {
+  if (task_) task_->WaitFence();
+}
+
+bool RenderingTaskImpl::IsFenceSignaled() { return !task_ || task_->IsFenceSignaled(); }
+
 }  // namespace core
 }  // namespace vkgs
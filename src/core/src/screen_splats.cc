@@ -11,8 +11,9 @@ ScreenSplatsImpl::ScreenSplatsImpl() {
   visible_point_count_ = gpu::Buffer::Create(
       VK_BUFFER_USAGE_TRANSFER_SRC_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT | VK_BUFFER_USAGE_STORAGE_BUFFER_BIT,
       sizeof(uint32_t));
-  draw_indirect_ = gpu::Buffer::Create(VK_BUFFER_USAGE_STORAGE_BUFFER_BIT | VK_BUFFER_USAGE_INDIRECT_BUFFER_BIT,
-                                       sizeof(VkDrawIndexedIndirectCommand));
+  draw_indirect_ = gpu::Buffer::Create(
+      VK_BUFFER_USAGE_TRANSFER_DST_BIT | VK_BUFFER_USAGE_STORAGE_BUFFER_BIT | VK_BUFFER_USAGE_INDIRECT_BUFFER_BIT,
+      (1 + kDrawChunkCount) * sizeof(VkDrawIndexedIndirectCommand));
   stats_ = gpu::Buffer::Create(
       VK_BUFFER_USAGE_TRANSFER_SRC_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT | VK_BUFFER_USAGE_STORAGE_BUFFER_BIT,
       sizeof(Stats));
@@ -27,5 +28,11 @@ void ScreenSplatsImpl::Update(uint32_t point_count) {
   }
 }
 
+void ScreenSplatsImpl::SetInstances(gpu::Buffer instances) {
+  instances_ = instances;
+  // Not owned, so the next Update allocates again.
+  point_count_ = 0;
+}
+
 }  // namespace core
 }  // namespace vkgs
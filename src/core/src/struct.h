@@ -23,6 +23,18 @@ struct ProjectionPushConstants {
   uint32_t sh_degree_draw;
   uint32_t record_stat;
   int opacity_degree;
+  uint32_t front_to_back;
+  uint32_t view_count;
+};
+
+// std140, per-draw invariants of projection.
+struct ProjectionUniforms {
+  alignas(16) glm::mat4 model_view;
+  glm::mat4 projection;
+  glm::vec4 camera_model_position;
+  glm::vec2 low_pass;
+  float sh_lod_scale;
+  float color_cache_cos;
 };
 
 struct Camera {
@@ -30,6 +42,26 @@ struct Camera {
   glm::mat4 view;
   glm::vec4 camera_position;
   glm::uvec2 screen_size;
+
+  // Depth pyramid of the previous frame in the ring slot, for occlusion culling.
+  alignas(16) glm::mat4 hiz_projection;
+  glm::mat4 hiz_view;
+  glm::vec4 hiz_camera_position;
+  glm::uvec2 hiz_screen_size;
+  uint32_t hiz_level_count;
+
+  // Eye cameras of a stereo pair. projection and view above are their midpoint camera.
+  alignas(16) glm::mat4 stereo_view_projection[2];
+};
+
+struct TilePushConstants {
+  alignas(16) glm::vec4 background;
+  glm::uvec2 screen_size;
+  glm::uvec2 tile_count;
+  uint32_t point_count;
+  uint32_t tile_capacity;
+  float confidence_radius;
+  alignas(16) glm::mat4 projection_inverse;
 };
 
 struct SplatPushConstants {
@@ -37,6 +69,37 @@ struct SplatPushConstants {
   float confidence_radius;
 };
 
+struct HizPushConstants {
+  alignas(16) glm::uvec2 src_size;
+  glm::uvec2 dst_size;
+  uint32_t src_offset;
+  uint32_t dst_offset;
+  uint32_t level;
+};
+
+struct OutputPushConstants {
+  alignas(16) glm::uvec2 screen_size;
+  uint32_t format;
+  uint32_t planar;
+  uint32_t srgb;
+  uint32_t byte_offset;
+  uint32_t byte_count;
+  uint32_t element_offset;
+};
+
+struct EquirectPushConstants {
+  alignas(16) glm::uvec2 screen_size;
+  uint32_t face_size;
+  float ndc_sign_x;
+  float ndc_sign_y;
+};
+
+struct ScreenPushConstants {
+  alignas(16) glm::vec4 background;
+  float saturation_alpha;
+  uint32_t chunk;
+};
+
 }  // namespace core
 }  // namespace vkgs
 
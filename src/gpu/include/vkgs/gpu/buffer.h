@@ -15,6 +15,14 @@ namespace gpu {
 class VKGS_GPU_API BufferImpl : public Object {
  public:
   BufferImpl(VkBufferUsageFlags usage, VkDeviceSize size, bool host = false);
+
+  /**
+   * @brief Buffer over caller-owned host memory, imported with VK_EXT_external_memory_host.
+   *
+   * host_pointer and size must be aligned to the device's min_imported_host_pointer_alignment, and the memory must
+   * outlive the buffer. data() is null if the memory cannot be imported.
+   */
+  BufferImpl(VkBufferUsageFlags usage, VkDeviceSize size, void* host_pointer);
   ~BufferImpl() override;
 
   operator VkBuffer() const noexcept { return buffer_; }
@@ -37,6 +45,7 @@ class VKGS_GPU_API BufferImpl : public Object {
   VkDeviceSize size_ = 0;
   VkBuffer buffer_ = VK_NULL_HANDLE;
   void* allocation_ = VK_NULL_HANDLE;
+  VkDeviceMemory imported_memory_ = VK_NULL_HANDLE;
   void* ptr_ = nullptr;
 };
 
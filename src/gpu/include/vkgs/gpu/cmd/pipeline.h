@@ -20,10 +20,15 @@ class VKGS_GPU_API Pipeline {
 
   Pipeline& Storage(int binding, VkBuffer buffer);
 
+  /** @brief Storage buffer range. offset must be aligned to the device's min_storage_buffer_offset_alignment. */
+  Pipeline& Storage(int binding, VkBuffer buffer, VkDeviceSize offset, VkDeviceSize range);
+
   Pipeline& Uniform(int binding, VkBuffer buffer);
 
   Pipeline& Input(int binding, VkImageView image_view, VkImageLayout layout);
 
+  Pipeline& StorageImage(int binding, VkImageView image_view, VkImageLayout layout);
+
   Pipeline& PushConstant(VkShaderStageFlags stage, uint32_t offset, uint32_t size, const void* values);
 
   Pipeline& Bind(VkPipeline pipeline);
@@ -41,6 +46,8 @@ class VKGS_GPU_API Pipeline {
   struct BufferDescriptorInfo {
     VkDescriptorType type;
     VkBuffer buffer;
+    VkDeviceSize offset = 0;
+    VkDeviceSize range = VK_WHOLE_SIZE;
   };
   std::map<int, BufferDescriptorInfo> buffer_descriptors_;
 
@@ -3,6 +3,7 @@
 
 #include <cstdint>
 #include <memory>
+#include <vector>
 
 #include <vulkan/vulkan.h>
 
@@ -15,11 +16,16 @@ namespace gpu {
 
 class VKGS_GPU_API ComputePipelineImpl : public Object {
  public:
-  ComputePipelineImpl(VkPipelineLayout pipeline_layout, const uint32_t* shader, size_t size);
+  /**
+   * @brief Compute pipeline, with 32-bit specialization constants for constant ids 0, 1, ...
+   */
+  ComputePipelineImpl(VkPipelineLayout pipeline_layout, const uint32_t* shader, size_t size,
+                      const std::vector<uint32_t>& specialization_constants = {});
 
   template <size_t N>
-  ComputePipelineImpl(VkPipelineLayout pipeline_layout, const uint32_t (&shader)[N])
-      : ComputePipelineImpl(pipeline_layout, shader, N) {}
+  ComputePipelineImpl(VkPipelineLayout pipeline_layout, const uint32_t (&shader)[N],
+                      const std::vector<uint32_t>& specialization_constants = {})
+      : ComputePipelineImpl(pipeline_layout, shader, N, specialization_constants) {}
 
   ~ComputePipelineImpl() override;
 
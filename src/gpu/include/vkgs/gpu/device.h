@@ -45,6 +45,15 @@ class VKGS_GPU_API DeviceImpl : public std::enable_shared_from_this<DeviceImpl>
   uint32_t graphics_queue_index() const noexcept;
   uint32_t compute_queue_index() const noexcept;
   uint32_t transfer_queue_index() const noexcept;
+  bool pipeline_statistics_query() const noexcept { return pipeline_statistics_query_; }
+  /** @brief Alignment of host pointers imported as buffer memory, or 0 if host memory cannot be imported. */
+  VkDeviceSize min_imported_host_pointer_alignment() const noexcept { return min_imported_host_pointer_alignment_; }
+  /** @brief Largest width and height of a render target, within framebuffer and 2D image limits. */
+  uint32_t max_image_size() const noexcept { return max_image_size_; }
+  /** @brief Largest range of a storage buffer descriptor. */
+  VkDeviceSize max_storage_buffer_range() const noexcept { return max_storage_buffer_range_; }
+  /** @brief Alignment of storage buffer descriptor offsets. */
+  VkDeviceSize min_storage_buffer_offset_alignment() const noexcept { return min_storage_buffer_offset_alignment_; }
 
   auto instance() const noexcept { return instance_; }
   auto allocator() const noexcept { return allocator_; }
@@ -61,6 +70,9 @@ class VKGS_GPU_API DeviceImpl : public std::enable_shared_from_this<DeviceImpl>
 
   void WaitIdle();
 
+  /** @brief Bytes of device and host memory currently allocated through the allocator. */
+  uint64_t AllocatedMemorySize() const;
+
   // Internal
   void SetCurrentTask(Task* task) { current_task_ = task; }
   void ClearCurrentTask() { current_task_ = nullptr; }
@@ -71,6 +83,11 @@ class VKGS_GPU_API DeviceImpl : public std::enable_shared_from_this<DeviceImpl>
 
  private:
   std::string device_name_;
+  bool pipeline_statistics_query_ = false;
+  VkDeviceSize min_imported_host_pointer_alignment_ = 0;
+  uint32_t max_image_size_ = 0;
+  VkDeviceSize max_storage_buffer_range_ = 0;
+  VkDeviceSize min_storage_buffer_offset_alignment_ = 0;
 
   VkInstance instance_ = VK_NULL_HANDLE;
   VkDebugUtilsMessengerEXT messenger_ = VK_NULL_HANDLE;
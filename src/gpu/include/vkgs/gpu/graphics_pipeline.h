@@ -26,6 +26,12 @@ struct VKGS_GPU_API ShaderCode {
   size_t size = 0;
 };
 
+enum class BlendMode {
+  OVER,   // Back-to-front, pre-multiplied source over destination.
+  UNDER,  // Front-to-back, pre-multiplied source under destination.
+  ADD,    // Order-independent sum of source and destination.
+};
+
 struct GraphicsPipelineCreateInfo {
   VkPipelineLayout pipeline_layout;
   ShaderCode vertex_shader;
@@ -39,6 +45,7 @@ struct GraphicsPipelineCreateInfo {
   VkFormat depth_format;
   bool depth_test;
   bool depth_write;
+  BlendMode blend_mode = BlendMode::OVER;
 };
 
 class VKGS_GPU_API GraphicsPipelineImpl : public Object {
@@ -0,0 +1,43 @@
+#ifndef VKGS_GPU_PIPELINE_STATISTICS_H
+#define VKGS_GPU_PIPELINE_STATISTICS_H
+
+#include <vector>
+#include <memory>
+
+#include <vulkan/vulkan.h>
+
+#include "vkgs/common/shared_accessor.h"
+#include "vkgs/gpu/export_api.h"
+#include "vkgs/gpu/object.h"
+
+namespace vkgs {
+namespace gpu {
+
+/**
+ * @brief Pipeline statistics queries with a single statistic, e.g. fragment shader invocations.
+ */
+class VKGS_GPU_API PipelineStatisticsImpl : public Object {
+ public:
+  PipelineStatisticsImpl(VkQueryPipelineStatisticFlagBits statistic, uint32_t size);
+  ~PipelineStatisticsImpl() override;
+
+  void Begin(VkCommandBuffer cb);
+  void End(VkCommandBuffer cb);
+
+  /**
+   * @brief Sum of all recorded queries. Blocks until results are available.
+   */
+  uint64_t GetSum() const;
+
+ private:
+  VkQueryPool query_pool_ = VK_NULL_HANDLE;
+  uint32_t size_ = 0;
+  uint32_t counter_ = 0;
+};
+
+class VKGS_GPU_API PipelineStatistics : public SharedAccessor<PipelineStatistics, PipelineStatisticsImpl> {};
+
+}  // namespace gpu
+}  // namespace vkgs
+
+#endif  // VKGS_GPU_PIPELINE_STATISTICS_H
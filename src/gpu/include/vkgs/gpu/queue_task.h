@@ -24,6 +24,12 @@ class VKGS_GPU_API QueueTaskImpl {
   bool IsDone();
   void Wait();
 
+  /** @brief Waits for the submission only, without running the callback. Other threads may record meanwhile. */
+  void WaitFence();
+
+  /** @brief Whether the submission is done, without running the callback. */
+  bool IsFenceSignaled();
+
  private:
   Fence fence_;
   Command command_;
@@ -30,7 +30,65 @@ BufferImpl::BufferImpl(VkBufferUsageFlags usage, VkDeviceSize size, bool host) :
   allocation_ = allocation;
 }
 
+BufferImpl::BufferImpl(VkBufferUsageFlags usage, VkDeviceSize size, void* host_pointer) : size_(size) {
+  if (device_->min_imported_host_pointer_alignment() == 0) return;
+
+  VkMemoryHostPointerPropertiesEXT host_pointer_properties = {VK_STRUCTURE_TYPE_MEMORY_HOST_POINTER_PROPERTIES_EXT};
+  if (vkGetMemoryHostPointerPropertiesEXT(device_, VK_EXTERNAL_MEMORY_HANDLE_TYPE_HOST_ALLOCATION_BIT_EXT,
+                                          host_pointer, &host_pointer_properties) != VK_SUCCESS) {
+    return;
+  }
+
+  VkExternalMemoryBufferCreateInfo external_info = {VK_STRUCTURE_TYPE_EXTERNAL_MEMORY_BUFFER_CREATE_INFO};
+  external_info.handleTypes = VK_EXTERNAL_MEMORY_HANDLE_TYPE_HOST_ALLOCATION_BIT_EXT;
+
+  VkBufferCreateInfo buffer_info = {VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO};
+  buffer_info.pNext = &external_info;
+  buffer_info.size = size;
+  buffer_info.usage = usage;
+  vkCreateBuffer(device_, &buffer_info, NULL, &buffer_);
+
+  VkMemoryRequirements requirements;
+  vkGetBufferMemoryRequirements(device_, buffer_, &requirements);
+
+  // Host visible memory type accepted by both the buffer and the host pointer.
+  VkPhysicalDeviceMemoryProperties memory_properties;
+  vkGetPhysicalDeviceMemoryProperties(device_->physical_device(), &memory_properties);
+  uint32_t type_bits = requirements.memoryTypeBits & host_pointer_properties.memoryTypeBits;
+  uint32_t memory_type_index = VK_MAX_MEMORY_TYPES;
+  for (uint32_t i = 0; i < memory_properties.memoryTypeCount; ++i) {
+    if ((type_bits & (1u << i)) &&
+        (memory_properties.memoryTypes[i].propertyFlags & VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT)) {
+      memory_type_index = i;
+      break;
+    }
+  }
+
+  VkImportMemoryHostPointerInfoEXT import_info = {VK_STRUCTURE_TYPE_IMPORT_MEMORY_HOST_POINTER_INFO_EXT};
+  import_info.handleType = VK_EXTERNAL_MEMORY_HANDLE_TYPE_HOST_ALLOCATION_BIT_EXT;
+  import_info.pHostPointer = host_pointer;
+
+  VkMemoryAllocateInfo allocate_info = {VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_INFO};
+  allocate_info.pNext = &import_info;
+  allocate_info.allocationSize = size;
+  allocate_info.memoryTypeIndex = memory_type_index;
+  if (memory_type_index == VK_MAX_MEMORY_TYPES || requirements.size > size ||
+      vkAllocateMemory(device_, &allocate_info, NULL, &imported_memory_) != VK_SUCCESS) {
+    imported_memory_ = VK_NULL_HANDLE;
+    return;
+  }
+
+  vkBindBufferMemory(device_, buffer_, imported_memory_, 0);
+  ptr_ = host_pointer;
+}
+
 BufferImpl::~BufferImpl() {
+  if (allocation_ == VK_NULL_HANDLE) {
+    vkDestroyBuffer(device_, buffer_, NULL);
+    vkFreeMemory(device_, imported_memory_, NULL);
+    return;
+  }
+
   VmaAllocator allocator = static_cast<VmaAllocator>(device_->allocator());
   VmaAllocation allocation = static_cast<VmaAllocation>(allocation_);
 
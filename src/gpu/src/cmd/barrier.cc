@@ -83,11 +83,14 @@ Barrier& Barrier::Memory(VkPipelineStageFlags2 src_stage, VkAccessFlags2 src_acc
 
 Barrier& Barrier::Image(VkPipelineStageFlags2 src_stage, VkAccessFlags2 src_access, VkPipelineStageFlags2 dst_stage,
                         VkAccessFlags2 dst_access, VkImageLayout old_layout, VkImageLayout new_layout, VkImage image) {
+  // Aspect from the attachment layout, either before or after the transition.
   VkImageAspectFlags aspect = VK_IMAGE_ASPECT_COLOR_BIT;
-  if (new_layout == VK_IMAGE_LAYOUT_DEPTH_ATTACHMENT_OPTIMAL) aspect = VK_IMAGE_ASPECT_DEPTH_BIT;
-  if (new_layout == VK_IMAGE_LAYOUT_STENCIL_ATTACHMENT_OPTIMAL) aspect = VK_IMAGE_ASPECT_STENCIL_BIT;
-  if (new_layout == VK_IMAGE_LAYOUT_DEPTH_STENCIL_ATTACHMENT_OPTIMAL)
-    aspect = VK_IMAGE_ASPECT_DEPTH_BIT | VK_IMAGE_ASPECT_STENCIL_BIT;
+  for (auto layout : {old_layout, new_layout}) {
+    if (layout == VK_IMAGE_LAYOUT_DEPTH_ATTACHMENT_OPTIMAL) aspect = VK_IMAGE_ASPECT_DEPTH_BIT;
+    if (layout == VK_IMAGE_LAYOUT_STENCIL_ATTACHMENT_OPTIMAL) aspect = VK_IMAGE_ASPECT_STENCIL_BIT;
+    if (layout == VK_IMAGE_LAYOUT_DEPTH_STENCIL_ATTACHMENT_OPTIMAL)
+      aspect = VK_IMAGE_ASPECT_DEPTH_BIT | VK_IMAGE_ASPECT_STENCIL_BIT;
+  }
 
   VkImageMemoryBarrier2 barrier = {VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER_2};
   barrier.srcStageMask = src_stage;
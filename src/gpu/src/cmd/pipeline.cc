@@ -18,6 +18,11 @@ Pipeline& Pipeline::Storage(int binding, VkBuffer buffer) {
   return *this;
 }
 
+Pipeline& Pipeline::Storage(int binding, VkBuffer buffer, VkDeviceSize offset, VkDeviceSize range) {
+  buffer_descriptors_[binding] = {VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, buffer, offset, range};
+  return *this;
+}
+
 Pipeline& Pipeline::Uniform(int binding, VkBuffer buffer) {
   buffer_descriptors_[binding] = {VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER, buffer};
   return *this;
@@ -28,6 +33,11 @@ Pipeline& Pipeline::Input(int binding, VkImageView image_view, VkImageLayout lay
   return *this;
 }
 
+Pipeline& Pipeline::StorageImage(int binding, VkImageView image_view, VkImageLayout layout) {
+  image_descriptors_[binding] = {VK_DESCRIPTOR_TYPE_STORAGE_IMAGE, image_view, layout};
+  return *this;
+}
+
 Pipeline& Pipeline::PushConstant(VkShaderStageFlags stage, uint32_t offset, uint32_t size, const void* values) {
   push_constants_.push_back(PushConstantData{stage, offset, size, values});
   return *this;
@@ -57,7 +67,7 @@ void Pipeline::Commit(VkCommandBuffer cb) {
 
     for (const auto& [binding, descriptor] : buffer_descriptors_) {
       auto& buffer_info = buffer_infos.emplace_back();
-      buffer_info = {descriptor.buffer, 0, VK_WHOLE_SIZE};
+      buffer_info = {descriptor.buffer, descriptor.offset, descriptor.range};
 
       auto& write = writes.emplace_back();
       write = {VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET};
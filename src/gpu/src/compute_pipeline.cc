@@ -5,18 +5,30 @@
 namespace vkgs {
 namespace gpu {
 
-ComputePipelineImpl::ComputePipelineImpl(VkPipelineLayout pipeline_layout, const uint32_t* shader, size_t size) {
+ComputePipelineImpl::ComputePipelineImpl(VkPipelineLayout pipeline_layout, const uint32_t* shader, size_t size,
+                                         const std::vector<uint32_t>& specialization_constants) {
   VkShaderModuleCreateInfo shader_module_info = {VK_STRUCTURE_TYPE_SHADER_MODULE_CREATE_INFO};
   shader_module_info.codeSize = size * sizeof(uint32_t);
   shader_module_info.pCode = shader;
   VkShaderModule shader_module;
   vkCreateShaderModule(device_, &shader_module_info, NULL, &shader_module);
 
+  std::vector<VkSpecializationMapEntry> map_entries(specialization_constants.size());
+  for (uint32_t i = 0; i < map_entries.size(); ++i) {
+    map_entries[i] = {i, static_cast<uint32_t>(i * sizeof(uint32_t)), sizeof(uint32_t)};
+  }
+  VkSpecializationInfo specialization_info = {};
+  specialization_info.mapEntryCount = map_entries.size();
+  specialization_info.pMapEntries = map_entries.data();
+  specialization_info.dataSize = specialization_constants.size() * sizeof(uint32_t);
+  specialization_info.pData = specialization_constants.data();
+
   VkComputePipelineCreateInfo pipeline_info = {VK_STRUCTURE_TYPE_COMPUTE_PIPELINE_CREATE_INFO};
   pipeline_info.stage = {VK_STRUCTURE_TYPE_PIPELINE_SHADER_STAGE_CREATE_INFO};
   pipeline_info.stage.stage = VK_SHADER_STAGE_COMPUTE_BIT;
   pipeline_info.stage.module = shader_module;
   pipeline_info.stage.pName = "main";
+  if (!specialization_constants.empty()) pipeline_info.stage.pSpecializationInfo = &specialization_info;
   pipeline_info.layout = pipeline_layout;
 
   vkCreateComputePipelines(device_, VK_NULL_HANDLE, 1, &pipeline_info, NULL, &pipeline_);
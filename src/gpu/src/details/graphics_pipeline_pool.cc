@@ -59,9 +59,14 @@ bool GraphicsPipelineCreateInfoLess::operator()(const GraphicsPipelineCreateInfo
   for (size_t i = 0; i < lhs.locations.size(); ++i) {
     if (lhs.locations[i] != rhs.locations[i]) return lhs.locations[i] < rhs.locations[i];
   }
+  if (lhs.input_indices.size() != rhs.input_indices.size()) return lhs.input_indices.size() < rhs.input_indices.size();
+  for (size_t i = 0; i < lhs.input_indices.size(); ++i) {
+    if (lhs.input_indices[i] != rhs.input_indices[i]) return lhs.input_indices[i] < rhs.input_indices[i];
+  }
   if (lhs.depth_format != rhs.depth_format) return lhs.depth_format < rhs.depth_format;
   if (lhs.depth_test != rhs.depth_test) return lhs.depth_test < rhs.depth_test;
   if (lhs.depth_write != rhs.depth_write) return lhs.depth_write < rhs.depth_write;
+  if (lhs.blend_mode != rhs.blend_mode) return lhs.blend_mode < rhs.blend_mode;
   return false;
 }
 
@@ -153,16 +158,25 @@ GraphicsPipeline GraphicsPipelinePoolImpl::Allocate(const GraphicsPipelineCreate
   depth_stencil_state.depthWriteEnable = create_info.depth_write;
   depth_stencil_state.depthCompareOp = VK_COMPARE_OP_LESS_OR_EQUAL;
 
-  // TODO: blend equation
+  // Over: src + (1 - src.a) * dst. Under: (1 - dst.a) * src + dst. Add: src + dst.
+  VkBlendFactor src_blend_factor = VK_BLEND_FACTOR_ONE;
+  VkBlendFactor dst_blend_factor = VK_BLEND_FACTOR_ONE_MINUS_SRC_ALPHA;
+  if (create_info.blend_mode == BlendMode::UNDER) {
+    src_blend_factor = VK_BLEND_FACTOR_ONE_MINUS_DST_ALPHA;
+    dst_blend_factor = VK_BLEND_FACTOR_ONE;
+  } else if (create_info.blend_mode == BlendMode::ADD) {
+    dst_blend_factor = VK_BLEND_FACTOR_ONE;
+  }
+
   std::vector<VkPipelineColorBlendAttachmentState> color_attachments(create_info.formats.size());
   for (auto& color_attachment : color_attachments) {
     color_attachment = {};
     color_attachment.blendEnable = VK_TRUE;
-    color_attachment.srcColorBlendFactor = VK_BLEND_FACTOR_ONE;
-    color_attachment.dstColorBlendFactor = VK_BLEND_FACTOR_ONE_MINUS_SRC_ALPHA;
+    color_attachment.srcColorBlendFactor = src_blend_factor;
+    color_attachment.dstColorBlendFactor = dst_blend_factor;
     color_attachment.colorBlendOp = VK_BLEND_OP_ADD;
-    color_attachment.srcAlphaBlendFactor = VK_BLEND_FACTOR_ONE;
-    color_attachment.dstAlphaBlendFactor = VK_BLEND_FACTOR_ONE_MINUS_SRC_ALPHA;
+    color_attachment.srcAlphaBlendFactor = src_blend_factor;
+    color_attachment.dstAlphaBlendFactor = dst_blend_factor;
     color_attachment.alphaBlendOp = VK_BLEND_OP_ADD;
     color_attachment.colorWriteMask =
         VK_COLOR_COMPONENT_R_BIT | VK_COLOR_COMPONENT_G_BIT | VK_COLOR_COMPONENT_B_BIT | VK_COLOR_COMPONENT_A_BIT;
@@ -1,5 +1,7 @@
 #include "vkgs/gpu/device.h"
 
+#include <algorithm>
+#include <cstring>
 #include <iostream>
 
 #include <volk.h>
@@ -166,6 +168,24 @@ DeviceImpl::DeviceImpl(const DeviceCreateInfo& create_info) {
   };
   if (create_info.enable_viewer) device_extensions.push_back(VK_KHR_SWAPCHAIN_EXTENSION_NAME);
 
+  // Optional, for importing host memory as readback destination.
+  uint32_t extension_count = 0;
+  vkEnumerateDeviceExtensionProperties(physical_device_, NULL, &extension_count, NULL);
+  std::vector<VkExtensionProperties> extension_properties(extension_count);
+  vkEnumerateDeviceExtensionProperties(physical_device_, NULL, &extension_count, extension_properties.data());
+  for (const auto& extension : extension_properties) {
+    if (std::strcmp(extension.extensionName, VK_EXT_EXTERNAL_MEMORY_HOST_EXTENSION_NAME) == 0) {
+      device_extensions.push_back(VK_EXT_EXTERNAL_MEMORY_HOST_EXTENSION_NAME);
+
+      VkPhysicalDeviceExternalMemoryHostPropertiesEXT external_memory_host_properties = {
+          VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_EXTERNAL_MEMORY_HOST_PROPERTIES_EXT};
+      VkPhysicalDeviceProperties2 properties = {VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_PROPERTIES_2};
+      properties.pNext = &external_memory_host_properties;
+      vkGetPhysicalDeviceProperties2(physical_device_, &properties);
+      min_imported_host_pointer_alignment_ = external_memory_host_properties.minImportedHostPointerAlignment;
+    }
+  }
+
   // VkPhysicalDeviceVulkan14Features
   VkPhysicalDeviceDynamicRenderingLocalReadFeatures dynamic_rendering_local_read_features = {
       VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_DYNAMIC_RENDERING_LOCAL_READ_FEATURES};
@@ -204,12 +224,20 @@ DeviceImpl::DeviceImpl(const DeviceCreateInfo& create_info) {
   swapchain_maintenance_features.pNext = &k16bit_storage_features;
   swapchain_maintenance_features.swapchainMaintenance1 = VK_TRUE;
 
+  // VkPhysicalDeviceFeatures
+  VkPhysicalDeviceFeatures supported_features;
+  vkGetPhysicalDeviceFeatures(physical_device_, &supported_features);
+  VkPhysicalDeviceFeatures features = {};
+  features.pipelineStatisticsQuery = supported_features.pipelineStatisticsQuery;
+  pipeline_statistics_query_ = supported_features.pipelineStatisticsQuery;
+
   VkDeviceCreateInfo device_info = {VK_STRUCTURE_TYPE_DEVICE_CREATE_INFO};
   device_info.pNext = &swapchain_maintenance_features;
   device_info.queueCreateInfoCount = queue_create_infos.size();
   device_info.pQueueCreateInfos = queue_create_infos.data();
   device_info.enabledExtensionCount = device_extensions.size();
   device_info.ppEnabledExtensionNames = device_extensions.data();
+  device_info.pEnabledFeatures = &features;
   vkCreateDevice(physical_device_, &device_info, NULL, &device_);
   volkLoadDevice(device_);
 
@@ -223,6 +251,10 @@ DeviceImpl::DeviceImpl(const DeviceCreateInfo& create_info) {
   VkPhysicalDeviceProperties device_properties;
   vkGetPhysicalDeviceProperties(physical_device_, &device_properties);
   device_name_ = device_properties.deviceName;
+  const auto& limits = device_properties.limits;
+  max_image_size_ = std::min({limits.maxFramebufferWidth, limits.maxFramebufferHeight, limits.maxImageDimension2D});
+  max_storage_buffer_range_ = limits.maxStorageBufferRange;
+  min_storage_buffer_offset_alignment_ = limits.minStorageBufferOffsetAlignment;
 
   semaphore_pool_ = SemaphorePool::Create(device_);
   fence_pool_ = FencePool::Create(device_);
@@ -287,6 +319,12 @@ void DeviceImpl::WaitIdle() {
   vkDeviceWaitIdle(device_);
 }
 
+uint64_t DeviceImpl::AllocatedMemorySize() const {
+  VmaTotalStatistics statistics;
+  vmaCalculateStatistics(static_cast<VmaAllocator>(allocator_), &statistics);
+  return statistics.total.statistics.allocationBytes;
+}
+
 QueueTask DeviceImpl::AddQueueTask(Fence fence, Command command, std::vector<std::shared_ptr<Object>> objects,
                                    std::function<void()> callback) {
   return task_monitor_->Add(fence, command, std::move(objects), callback);
@@ -0,0 +1,52 @@
+#include "vkgs/gpu/pipeline_statistics.h"
+
+#include <stdexcept>
+
+#include <volk.h>
+
+namespace vkgs {
+namespace gpu {
+
+PipelineStatisticsImpl::PipelineStatisticsImpl(VkQueryPipelineStatisticFlagBits statistic, uint32_t size)
+    : size_(size) {
+  if (!device_->pipeline_statistics_query()) {
+    throw std::runtime_error("PipelineStatistics: pipelineStatisticsQuery is not supported");
+  }
+
+  VkQueryPoolCreateInfo query_pool_info = {VK_STRUCTURE_TYPE_QUERY_POOL_CREATE_INFO};
+  query_pool_info.queryType = VK_QUERY_TYPE_PIPELINE_STATISTICS;
+  query_pool_info.queryCount = size;
+  query_pool_info.pipelineStatistics = statistic;
+  vkCreateQueryPool(device_, &query_pool_info, NULL, &query_pool_);
+  vkResetQueryPool(device_, query_pool_, 0, size);
+}
+
+PipelineStatisticsImpl::~PipelineStatisticsImpl() { vkDestroyQueryPool(device_, query_pool_, NULL); }
+
+void PipelineStatisticsImpl::Begin(VkCommandBuffer cb) {
+  if (counter_ >= size_) {
+    throw std::runtime_error("PipelineStatistics: counter out of range");
+  }
+
+  vkCmdBeginQuery(cb, query_pool_, counter_, 0);
+}
+
+void PipelineStatisticsImpl::End(VkCommandBuffer cb) {
+  vkCmdEndQuery(cb, query_pool_, counter_);
+  counter_++;
+}
+
+uint64_t PipelineStatisticsImpl::GetSum() const {
+  std::vector<uint64_t> results(counter_);
+  if (counter_ > 0) {
+    vkGetQueryPoolResults(device_, query_pool_, 0, counter_, counter_ * sizeof(uint64_t), results.data(),
+                          sizeof(uint64_t), VK_QUERY_RESULT_64_BIT | VK_QUERY_RESULT_WAIT_BIT);
+  }
+
+  uint64_t sum = 0;
+  for (auto result : results) sum += result;
+  return sum;
+}
+
+}  // namespace gpu
+}  // namespace vkgs
@@ -31,5 +31,9 @@ void QueueTaskImpl::Wait() {
   }
 }
 
+void QueueTaskImpl::WaitFence() { fence_->Wait(); }
+
+bool QueueTaskImpl::IsFenceSignaled() { return fence_->IsSignaled(); }
+
 }  // namespace gpu
 }  // namespace vkgs
@@ -1,7 +1,9 @@
 #ifndef VKGS_VIEWER_VIEWER_H
 #define VKGS_VIEWER_VIEWER_H
 
+#include <functional>
 #include <memory>
+#include <mutex>
 
 #include "vkgs/common/shared_accessor.h"
 
@@ -24,6 +26,12 @@ class VKGS_VIEWER_API ViewerImpl {
   void SetRenderer(core::Renderer renderer);
   void SetSplats(core::GaussianSplats splats);
 
+  /**
+   * @brief Lock taken by Run while it uses the renderer or the device, e.g. shared with other threads drawing with the
+   * same renderer. Released while polling events and waiting for the next swapchain image.
+   */
+  void SetLock(std::function<std::unique_lock<std::mutex>()> lock);
+
   void AddCamera(const CameraParams& camera_params);
   void ClearCameras();
 
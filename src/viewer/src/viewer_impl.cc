@@ -256,6 +256,7 @@ void ViewerImpl::Impl::DrawUi() {
       ImGui::ColorEdit3("Background", glm::value_ptr(viewer_options_.background));
 
       ImGui::SliderInt("SH degree", &viewer_options_.sh_degree, 0, splats_->sh_degree());
+      ImGui::SliderFloat("SH LOD radius", &viewer_options_.sh_lod_radius, 0.f, 64.f, "%.1f px");
       ImGui::SliderFloat("Eps2d", &viewer_options_.eps2d, 0.0001f, 10.f, "%.4f", ImGuiSliderFlags_Logarithmic);
       ImGui::SliderFloat("Radius", &viewer_options_.confidence_radius, 1.f, 5.f, "%.3f");
     }
@@ -375,6 +376,9 @@ void ViewerImpl::Impl::DrawUi() {
 }
 
 void ViewerImpl::Impl::Run() {
+  std::unique_lock<std::mutex> lock;
+  if (lock_) lock = lock_();
+
   InitializeWindow();
 
   // Graphics pipelines
@@ -511,6 +515,7 @@ void ViewerImpl::Impl::Run() {
       .vsync = true,
       .gamma_correction = false,
       .sh_degree = static_cast<int>(splats_->sh_degree()),
+      .sh_lod_radius = 0.f,
       .render_type = 0,
       .background = {0.f, 0.f, 0.f},
       .eps2d = 0.01f,
@@ -528,7 +533,10 @@ void ViewerImpl::Impl::Run() {
   fps_window_ = SampledMovingWindow(5.f, 0.01f);
   visible_point_count_window_ = SampledMovingWindow(5.f, 0.01f);
   while (!glfwWindowShouldClose(window_)) {
+    // Other users of the lock run while events are polled.
+    if (lock) lock.unlock();
     glfwPollEvents();
+    if (lock_) lock = lock_();
 
     ImGui_ImplVulkan_NewFrame();
     ImGui_ImplGlfw_NewFrame();
@@ -543,7 +551,11 @@ void ViewerImpl::Impl::Run() {
     if (is_minimized) {
       ImGui::EndFrame();
     } else {
+      // Acquiring waits for the frame in flight, which only needs the swapchain.
+      if (lock) lock.unlock();
       auto present_image_info = swapchain_->AcquireNextImage();
+      if (lock_) lock = lock_();
+
       Draw(present_image_info);
       swapchain_->Present();
     }
@@ -593,6 +605,7 @@ void ViewerImpl::Impl::Draw(const gpu::PresentImageInfo& present_image_info) {
       .background = {0.f, 0.f, 0.f},  // unused
       .eps2d = viewer_options_.eps2d,
       .sh_degree = viewer_options_.render_type == 0 ? viewer_options_.sh_degree : 0,
+      .sh_lod_radius = viewer_options_.sh_lod_radius,
       .record_stat = viewer_options_.show_stat,
   };
 
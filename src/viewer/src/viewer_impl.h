@@ -3,7 +3,9 @@
 
 #include "vkgs/viewer/viewer.h"
 
+#include <functional>
 #include <memory>
+#include <mutex>
 #include <array>
 #include <vector>
 
@@ -37,6 +39,7 @@ class ViewerImpl::Impl {
 
   void SetRenderer(core::Renderer renderer) { renderer_ = renderer; }
   void SetSplats(core::GaussianSplats splats) { splats_ = splats; }
+  void SetLock(std::function<std::unique_lock<std::mutex>()> lock) { lock_ = lock; }
 
   void AddCamera(const CameraParams& camera_params) { camera_params_.push_back(camera_params); }
   void ClearCameras() { camera_params_.clear(); }
@@ -64,6 +67,7 @@ class ViewerImpl::Impl {
     bool vsync;
     bool gamma_correction;
     int sh_degree;
+    float sh_lod_radius;
     int render_type;
     glm::vec3 background;
     float eps2d;
@@ -84,6 +88,7 @@ class ViewerImpl::Impl {
 
   core::Renderer renderer_;
   core::GaussianSplats splats_;
+  std::function<std::unique_lock<std::mutex>()> lock_;
   std::vector<CameraParams> camera_params_;
 
   gpu::PipelineLayout color_pipeline_layout_;
@@ -5,6 +5,19 @@
 
 namespace vkgs {
 
+enum class Rasterizer {
+  HARDWARE,
+  TILE,
+  OIT,
+};
+
+enum class OutputFormat {
+  RGBA8,
+  RGB8,
+  RGBA16F,
+  RGB32F,
+};
+
 struct DrawOptions {
   float view[16];        // column-major
   float projection[16];  // column-major
@@ -15,6 +28,16 @@ struct DrawOptions {
   float eps2d;
   float confidence_radius;
   int sh_degree;
+  float sh_lod_radius;
+  float color_cache_angle;
+  Rasterizer rasterizer;
+  bool front_to_back;
+  bool occlusion_culling;
+  OutputFormat output_format;
+  bool output_planar;
+  bool output_srgb;
+  bool output_depth;  // (alpha, expected depth, median depth, 0) as (H, W, 4) float32 into depth_dst.
+  uint32_t roi[4];    // (x, y, width, height) region drawn as an image of its size. Zero size for the whole image.
 };
 
 }  // namespace vkgs
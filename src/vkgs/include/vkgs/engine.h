@@ -3,6 +3,7 @@
 
 #include <memory>
 #include <string>
+#include <vector>
 
 #include "vkgs/export_api.h"
 
@@ -16,19 +17,56 @@ class RenderingTask;
 
 class VKGS_API Engine {
  public:
-  Engine();
+  /**
+   * @brief Engine drawing with ring_size frames in flight, in [2, 8].
+   *
+   * Engine calls may come from several threads, and are serialized by an engine lock. Waits on returned tasks block on
+   * the GPU without the lock, so other threads keep recording draws meanwhile.
+   */
+  explicit Engine(uint32_t ring_size = 2);
   ~Engine();
 
   const std::string& device_name() const noexcept;
   uint32_t graphics_queue_index() const noexcept;
   uint32_t compute_queue_index() const noexcept;
   uint32_t transfer_queue_index() const noexcept;
+  uint32_t ring_size() const noexcept;
 
   GaussianSplats LoadFromPly(const std::string& path, int sh_degree = -1);
   GaussianSplats CreateGaussianSplats(size_t size, const float* means, const float* quats, const float* scales,
                                       const float* opacities, const uint16_t* colors, int sh_degree,
                                       int opacity_degree);
-  RenderingTask Draw(GaussianSplats splats, const DrawOptions& draw_options, uint8_t* dst);
+  RenderingTask Draw(GaussianSplats splats, const DrawOptions& draw_options, uint8_t* dst, float* depth_dst = nullptr);
+
+  /**
+   * @brief Draw views of the same size and output format into dst of B consecutive images, recording several views
+   * per submission.
+   *
+   * Occlusion culling is not applied. The screen splat options of the first view are used for all views.
+   */
+  std::vector<RenderingTask> DrawBatch(GaussianSplats splats, const std::vector<DrawOptions>& draw_options,
+                                       uint8_t* dst, float* depth_dst = nullptr);
+
+  /**
+   * @brief DrawBatch of stereo pairs, (left, right) consecutive in draw_options, sharing one visibility and sort pass
+   * per pair.
+   */
+  std::vector<RenderingTask> DrawStereo(GaussianSplats splats, const std::vector<DrawOptions>& draw_options,
+                                        uint8_t* dst, float* depth_dst = nullptr);
+
+  /**
+   * @brief Draw an image beyond render target limits in square tiles of tile_size, copied into place in dst, with one
+   * rendering task per tile.
+   */
+  std::vector<RenderingTask> DrawTiled(GaussianSplats splats, const DrawOptions& draw_options, uint8_t* dst,
+                                       float* depth_dst, uint32_t tile_size);
+
+  /**
+   * @brief Draw the six cube faces around the camera into dst of 6 consecutive images, or one equirectangular
+   * panorama of (equirect_width / 2, equirect_width) if equirect_width is given.
+   */
+  std::vector<RenderingTask> DrawCubemap(GaussianSplats splats, const DrawOptions& draw_options, uint8_t* dst,
+                                         uint32_t equirect_width = 0);
 
   void AddCamera(const CameraParams& camera_params);
   void ClearCameras();
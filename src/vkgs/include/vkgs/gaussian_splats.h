@@ -10,9 +10,14 @@ namespace core {
 class GaussianSplats;
 }
 
+class EngineLock;
+
 class VKGS_API GaussianSplats {
  public:
-  explicit GaussianSplats(core::GaussianSplats gaussian_splats);
+  /**
+   * @brief Splats of an engine, with the engine lock serializing their upload completion with recording.
+   */
+  GaussianSplats(core::GaussianSplats gaussian_splats, std::shared_ptr<EngineLock> lock);
   ~GaussianSplats();
 
   size_t size() const;
@@ -13,13 +13,24 @@ namespace core {
 class RenderingTask;
 }
 
+class EngineLock;
+
 class VKGS_API RenderingTask {
  public:
-  explicit RenderingTask(core::RenderingTask task);
+  /**
+   * @brief Task of an engine draw, with the engine lock serializing its completion with recording.
+   */
+  RenderingTask(core::RenderingTask task, std::shared_ptr<EngineLock> lock);
   ~RenderingTask();
 
   void Wait();
 
+  /**
+   * @brief Whether the GPU is done, so that Wait only takes the engine lock for completion callbacks. Never blocks,
+   * for polling from event loops.
+   */
+  bool IsReady() const;
+
   const DrawResult& draw_result() const;
 
  private:
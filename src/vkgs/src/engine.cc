@@ -1,5 +1,7 @@
 #include "vkgs/engine.h"
 
+#include <mutex>
+
 #include <glm/glm.hpp>
 #include <glm/gtc/type_ptr.hpp>
 
@@ -12,12 +14,19 @@
 #include "vkgs/core/rendering_task.h"
 #include "vkgs/viewer/viewer.h"
 
+#include "engine_lock.h"
+
 namespace vkgs {
 
 class Engine::Impl {
  public:
-  Impl() : viewer_(viewer::Viewer::Create()), parser_(core::Parser::Create()), renderer_(core::Renderer::Create()) {
+  Impl(uint32_t ring_size)
+      : viewer_(viewer::Viewer::Create()),
+        parser_(core::Parser::Create()),
+        renderer_(core::Renderer::Create(ring_size)),
+        lock_(std::make_shared<EngineLock>()) {
     viewer_->SetRenderer(renderer_);
+    viewer_->SetLock([lock = lock_] { return lock->Lock(); });
   }
 
   ~Impl() = default;
@@ -26,36 +35,81 @@ class Engine::Impl {
   uint32_t graphics_queue_index() const noexcept { return renderer_->graphics_queue_index(); }
   uint32_t compute_queue_index() const noexcept { return renderer_->compute_queue_index(); }
   uint32_t transfer_queue_index() const noexcept { return renderer_->transfer_queue_index(); }
+  uint32_t ring_size() const noexcept { return renderer_->ring_size(); }
 
   GaussianSplats LoadFromPly(const std::string& path, int sh_degree) {
-    return GaussianSplats(parser_->LoadFromPly(path, sh_degree));
+    auto lock = lock_->Lock();
+    return GaussianSplats(parser_->LoadFromPly(path, sh_degree), lock_);
   }
 
   GaussianSplats CreateGaussianSplats(size_t size, const float* means, const float* quats, const float* scales,
                                       const float* opacities, const uint16_t* colors, int sh_degree,
                                       int opacity_degree) {
-    return GaussianSplats(
-        parser_->CreateGaussianSplats(size, means, quats, scales, opacities, colors, sh_degree, opacity_degree));
+    auto lock = lock_->Lock();
+    auto gaussian_splats =
+        parser_->CreateGaussianSplats(size, means, quats, scales, opacities, colors, sh_degree, opacity_degree);
+    return GaussianSplats(gaussian_splats, lock_);
   }
 
-  RenderingTask Draw(GaussianSplats splats, const DrawOptions& draw_options, uint8_t* dst) {
-    core::DrawOptions core_draw_options = {
-        .view = glm::make_mat4(draw_options.view),
-        .projection = glm::make_mat4(draw_options.projection),
-        .model = glm::make_mat4(draw_options.model),
-        .width = draw_options.width,
-        .height = draw_options.height,
-        .background = glm::make_vec3(draw_options.background),
-        .eps2d = draw_options.eps2d,
-        .sh_degree = draw_options.sh_degree,
+  RenderingTask Draw(GaussianSplats splats, const DrawOptions& draw_options, uint8_t* dst, float* depth_dst) {
+    auto lock = lock_->Lock();
+    core::ScreenSplatOptions core_screen_splat_options = {
+        .confidence_radius = draw_options.confidence_radius,
     };
+    return RenderingTask(
+        renderer_->Draw(splats.get(), ToCoreDrawOptions(draw_options), core_screen_splat_options, dst, depth_dst),
+        lock_);
+  }
+
+  std::vector<RenderingTask> DrawBatch(GaussianSplats splats, const std::vector<DrawOptions>& draw_options,
+                                       uint8_t* dst, float* depth_dst, bool stereo) {
+    if (draw_options.empty()) return {};
+
+    auto lock = lock_->Lock();
+    std::vector<core::DrawOptions> core_draw_options;
+    for (const auto& options : draw_options) core_draw_options.push_back(ToCoreDrawOptions(options));
+    core::ScreenSplatOptions core_screen_splat_options = {
+        .confidence_radius = draw_options[0].confidence_radius,
+    };
+
+    std::vector<RenderingTask> rendering_tasks;
+    auto core_rendering_tasks =
+        stereo ? renderer_->DrawStereo(splats.get(), core_draw_options, core_screen_splat_options, dst, depth_dst)
+               : renderer_->DrawBatch(splats.get(), core_draw_options, core_screen_splat_options, dst, depth_dst);
+    for (auto rendering_task : core_rendering_tasks) rendering_tasks.push_back(RenderingTask(rendering_task, lock_));
+    return rendering_tasks;
+  }
+
+  std::vector<RenderingTask> DrawTiled(GaussianSplats splats, const DrawOptions& draw_options, uint8_t* dst,
+                                       float* depth_dst, uint32_t tile_size) {
+    auto lock = lock_->Lock();
     core::ScreenSplatOptions core_screen_splat_options = {
         .confidence_radius = draw_options.confidence_radius,
     };
-    return RenderingTask(renderer_->Draw(splats.get(), core_draw_options, core_screen_splat_options, dst));
+
+    std::vector<RenderingTask> rendering_tasks;
+    auto core_rendering_tasks = renderer_->DrawTiled(splats.get(), ToCoreDrawOptions(draw_options),
+                                                     core_screen_splat_options, dst, depth_dst, tile_size);
+    for (auto rendering_task : core_rendering_tasks) rendering_tasks.push_back(RenderingTask(rendering_task, lock_));
+    return rendering_tasks;
+  }
+
+  std::vector<RenderingTask> DrawCubemap(GaussianSplats splats, const DrawOptions& draw_options, uint8_t* dst,
+                                         uint32_t equirect_width) {
+    auto lock = lock_->Lock();
+    core::ScreenSplatOptions core_screen_splat_options = {
+        .confidence_radius = draw_options.confidence_radius,
+    };
+
+    std::vector<RenderingTask> rendering_tasks;
+    auto core_rendering_tasks = renderer_->DrawCubemap(splats.get(), ToCoreDrawOptions(draw_options),
+                                                       core_screen_splat_options, dst, equirect_width);
+    for (auto rendering_task : core_rendering_tasks) rendering_tasks.push_back(RenderingTask(rendering_task, lock_));
+    return rendering_tasks;
   }
 
   void AddCamera(const CameraParams& camera_params) {
+    auto lock = lock_->Lock();
     viewer::CameraParams viewer_camera_params = {
         .extrinsic = glm::make_mat4(camera_params.extrinsic),
         .intrinsic = glm::make_mat3(camera_params.intrinsic),
@@ -65,20 +119,57 @@ class Engine::Impl {
     viewer_->AddCamera(viewer_camera_params);
   }
 
-  void ClearCameras() { viewer_->ClearCameras(); }
+  void ClearCameras() {
+    auto lock = lock_->Lock();
+    viewer_->ClearCameras();
+  }
 
   void Show(GaussianSplats splats) {
-    viewer_->SetSplats(splats.get());
+    std::lock_guard<std::mutex> show_lock(show_mutex_);
+    {
+      auto lock = lock_->Lock();
+      viewer_->SetSplats(splats.get());
+    }
+
+    // The viewer takes the engine lock per frame, so that other threads draw and release objects meanwhile.
     viewer_->Run();
   }
 
  private:
+  static core::DrawOptions ToCoreDrawOptions(const DrawOptions& draw_options) {
+    return {
+        .view = glm::make_mat4(draw_options.view),
+        .projection = glm::make_mat4(draw_options.projection),
+        .model = glm::make_mat4(draw_options.model),
+        .width = draw_options.width,
+        .height = draw_options.height,
+        .background = glm::make_vec3(draw_options.background),
+        .eps2d = draw_options.eps2d,
+        .sh_degree = draw_options.sh_degree,
+        .sh_lod_radius = draw_options.sh_lod_radius,
+        .color_cache_angle = draw_options.color_cache_angle,
+        .rasterizer = static_cast<core::Rasterizer>(draw_options.rasterizer),
+        .front_to_back = draw_options.front_to_back,
+        .occlusion_culling = draw_options.occlusion_culling,
+        .output_format = static_cast<core::OutputFormat>(draw_options.output_format),
+        .output_planar = draw_options.output_planar,
+        .output_srgb = draw_options.output_srgb,
+        .output_depth = draw_options.output_depth,
+        .roi = glm::make_vec4(draw_options.roi),
+    };
+  }
+
   viewer::Viewer viewer_;
   core::Parser parser_;
   core::Renderer renderer_;
+
+  // Serializes recording, and completion callbacks of returned tasks. Nothing below the engine is thread-safe.
+  std::shared_ptr<EngineLock> lock_;
+  // Serializes viewer runs, which only take the engine lock per frame.
+  std::mutex show_mutex_;
 };
 
-Engine::Engine() : impl_(std::make_shared<Impl>()) {}
+Engine::Engine(uint32_t ring_size) : impl_(std::make_shared<Impl>(ring_size)) {}
 
 Engine::~Engine() = default;
 
@@ -86,6 +177,7 @@ const std::string& Engine::device_name() const noexcept { return impl_->device_n
 uint32_t Engine::graphics_queue_index() const noexcept { return impl_->graphics_queue_index(); }
 uint32_t Engine::compute_queue_index() const noexcept { return impl_->compute_queue_index(); }
 uint32_t Engine::transfer_queue_index() const noexcept { return impl_->transfer_queue_index(); }
+uint32_t Engine::ring_size() const noexcept { return impl_->ring_size(); }
 
 GaussianSplats Engine::LoadFromPly(const std::string& path, int sh_degree) {
   return impl_->LoadFromPly(path, sh_degree);
@@ -97,8 +189,28 @@ GaussianSplats Engine::CreateGaussianSplats(size_t size, const float* means, con
   return impl_->CreateGaussianSplats(size, means, quats, scales, opacities, colors, sh_degree, opacity_degree);
 }
 
-RenderingTask Engine::Draw(GaussianSplats splats, const DrawOptions& draw_options, uint8_t* dst) {
-  return impl_->Draw(splats, draw_options, dst);
+RenderingTask Engine::Draw(GaussianSplats splats, const DrawOptions& draw_options, uint8_t* dst, float* depth_dst) {
+  return impl_->Draw(splats, draw_options, dst, depth_dst);
+}
+
+std::vector<RenderingTask> Engine::DrawBatch(GaussianSplats splats, const std::vector<DrawOptions>& draw_options,
+                                             uint8_t* dst, float* depth_dst) {
+  return impl_->DrawBatch(splats, draw_options, dst, depth_dst, false);
+}
+
+std::vector<RenderingTask> Engine::DrawStereo(GaussianSplats splats, const std::vector<DrawOptions>& draw_options,
+                                              uint8_t* dst, float* depth_dst) {
+  return impl_->DrawBatch(splats, draw_options, dst, depth_dst, true);
+}
+
+std::vector<RenderingTask> Engine::DrawTiled(GaussianSplats splats, const DrawOptions& draw_options, uint8_t* dst,
+                                             float* depth_dst, uint32_t tile_size) {
+  return impl_->DrawTiled(splats, draw_options, dst, depth_dst, tile_size);
+}
+
+std::vector<RenderingTask> Engine::DrawCubemap(GaussianSplats splats, const DrawOptions& draw_options, uint8_t* dst,
+                                               uint32_t equirect_width) {
+  return impl_->DrawCubemap(splats, draw_options, dst, equirect_width);
 }
 
 void Engine::AddCamera(const CameraParams& camera_params) { impl_->AddCamera(camera_params); }
@@ -0,0 +1,29 @@
+#include "engine_lock.h"
+
+#include <utility>
+
+namespace vkgs {
+
+EngineLock::EngineLock() = default;
+
+EngineLock::~EngineLock() = default;
+
+std::unique_lock<std::mutex> EngineLock::Lock() {
+  std::unique_lock<std::mutex> lock(mutex_);
+
+  std::vector<std::shared_ptr<void>> releases;
+  {
+    std::lock_guard<std::mutex> release_lock(release_mutex_);
+    releases.swap(releases_);
+  }
+  releases.clear();
+
+  return lock;
+}
+
+void EngineLock::Release(std::shared_ptr<void> object) {
+  std::lock_guard<std::mutex> release_lock(release_mutex_);
+  releases_.push_back(std::move(object));
+}
+
+}  // namespace vkgs
@@ -0,0 +1,36 @@
+#ifndef VKGS_ENGINE_LOCK_H
+#define VKGS_ENGINE_LOCK_H
+
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace vkgs {
+
+/**
+ * @brief Engine lock, serializing recording with completion callbacks and releases of engine objects.
+ *
+ * Objects dropped by other threads, e.g. Python objects collected while the viewer records a frame, are queued instead
+ * of waiting for the lock, and released by the next Lock.
+ */
+class EngineLock {
+ public:
+  EngineLock();
+  ~EngineLock();
+
+  /** @brief Locks the engine, then releases queued objects under the lock. */
+  std::unique_lock<std::mutex> Lock();
+
+  /** @brief Queues a reference to release under the lock. Never waits for the engine lock. */
+  void Release(std::shared_ptr<void> object);
+
+ private:
+  std::mutex mutex_;
+
+  std::mutex release_mutex_;
+  std::vector<std::shared_ptr<void>> releases_;
+};
+
+}  // namespace vkgs
+
+#endif  // VKGS_ENGINE_LOCK_H
@@ -2,25 +2,35 @@
 
 #include "vkgs/core/gaussian_splats.h"
 
+#include "engine_lock.h"
+
 namespace vkgs {
 
 class GaussianSplats::Impl {
  public:
-  Impl(core::GaussianSplats gaussian_splats) : gaussian_splats_(gaussian_splats) {}
+  Impl(core::GaussianSplats gaussian_splats, std::shared_ptr<EngineLock> lock)
+      : gaussian_splats_(gaussian_splats), lock_(lock) {}
 
-  ~Impl() = default;
+  ~Impl() { lock_->Release(gaussian_splats_.impl()); }
 
   size_t size() const { return gaussian_splats_->size(); }
 
-  void Wait() const { gaussian_splats_->Wait(); }
+  void Wait() const {
+    gaussian_splats_->WaitFence();
+
+    auto lock = lock_->Lock();
+    gaussian_splats_->Wait();
+  }
 
   core::GaussianSplats get() const noexcept { return gaussian_splats_; }
 
  private:
   core::GaussianSplats gaussian_splats_;
+  std::shared_ptr<EngineLock> lock_;
 };
 
-GaussianSplats::GaussianSplats(core::GaussianSplats gaussian_splats) : impl_(std::make_shared<Impl>(gaussian_splats)) {}
+GaussianSplats::GaussianSplats(core::GaussianSplats gaussian_splats, std::shared_ptr<EngineLock> lock)
+    : impl_(std::make_shared<Impl>(gaussian_splats, lock)) {}
 
 GaussianSplats::~GaussianSplats() = default;
 
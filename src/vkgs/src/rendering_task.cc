@@ -2,14 +2,22 @@
 
 #include "vkgs/core/rendering_task.h"
 
+#include "engine_lock.h"
+
 namespace vkgs {
 
 class RenderingTask::Impl {
  public:
-  Impl(core::RenderingTask task) : task_(task) {}
-  ~Impl() = default;
+  Impl(core::RenderingTask task, std::shared_ptr<EngineLock> lock) : task_(task), lock_(lock) {}
+
+  // The last reference returns command buffers to their pools, so it is released under the lock by the next engine
+  // call rather than waiting here, e.g. while the viewer holds the lock.
+  ~Impl() { lock_->Release(task_.impl()); }
 
   void Wait() {
+    task_->WaitFence();
+
+    auto lock = lock_->Lock();
     task_->Wait();
 
     auto result = task_->draw_result();
@@ -17,22 +25,31 @@ class RenderingTask::Impl {
         .compute_timestamp = result.compute_timestamp,
         .graphics_timestamp = result.graphics_timestamp,
         .transfer_timestamp = result.transfer_timestamp,
+        .fragment_count = result.fragment_count,
+        .occlusion_culled_count = result.occlusion_culled_count,
+        .dropped_tile_pair_count = result.dropped_tile_pair_count,
     };
   }
 
+  bool IsReady() const { return task_->IsFenceSignaled(); }
+
   const DrawResult& draw_result() const { return result_; }
 
  private:
   core::RenderingTask task_;
+  std::shared_ptr<EngineLock> lock_;
   DrawResult result_ = {};
 };
 
-RenderingTask::RenderingTask(core::RenderingTask task) : impl_(std::make_shared<Impl>(task)) {}
+RenderingTask::RenderingTask(core::RenderingTask task, std::shared_ptr<EngineLock> lock)
+    : impl_(std::make_shared<Impl>(task, lock)) {}
 
 RenderingTask::~RenderingTask() = default;
 
 void RenderingTask::Wait() { impl_->Wait(); }
 
+bool RenderingTask::IsReady() const { return impl_->IsReady(); }
+
 const DrawResult& RenderingTask::draw_result() const { return impl_->draw_result(); }
 
 }  // namespace vkgs
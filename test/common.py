@@ -0,0 +1,74 @@
+import math
+
+import numpy as np
+
+
+def sigmoid(x):
+    return 1.0 / (1.0 + np.exp(-x))
+
+
+def random_quat(N: int):
+    u1 = np.random.rand(N)
+    u2 = np.random.rand(N)
+    u3 = np.random.rand(N)
+
+    q = np.stack(
+        (
+            np.sqrt(1 - u1) * np.sin(2 * np.pi * u2),
+            np.sqrt(1 - u1) * np.cos(2 * np.pi * u2),
+            np.sqrt(u1) * np.sin(2 * np.pi * u3),
+            np.sqrt(u1) * np.cos(2 * np.pi * u3),
+        ),
+        axis=-1,
+    )
+    return q
+
+
+def random_splat_params(N: int, radius: float = 2.5) -> dict[str, np.ndarray]:
+    """Arguments of ss.gaussian_splats for N random splats around the origin."""
+    return dict(
+        means=np.random.randn(N, 3) * radius,
+        quats=random_quat(N),
+        scales=np.random.rand(N, 3) * 0.49 + 0.01,
+        opacities=sigmoid(np.random.rand(N) * 3 - 3),
+        colors=np.random.rand(N, 16, 3) * 2 - 1,
+    )
+
+
+def intrinsics(width: int, height: int, fov_x: float = 90.0):
+    focal = width / (2 * math.tan(math.radians(fov_x) / 2))
+    return np.array([[focal, 0, width / 2], [0, focal, height / 2], [0, 0, 1]])
+
+
+def orbit(N: int, radius: float = 10.0):
+    """(N, 4, 4) view matrices of cameras on a circle around the origin, looking at it."""
+    viewmats = []
+    for i in range(N):
+        theta = 2.0 * math.pi * (i / N)
+        C2W = np.zeros((4, 4))
+        C2W[:3, 0] = np.array([-math.sin(theta), 0.0, -math.cos(theta)])
+        C2W[:3, 1] = -np.array([0.0, 1.0, 0.0])
+        C2W[:3, 2] = -np.array([math.cos(theta), 0.0, -math.sin(theta)])
+        C2W[:3, 3] = np.array([math.cos(theta), 0.0, -math.sin(theta)]) * radius
+        C2W[3, 3] = 1.0
+        viewmats.append(np.linalg.inv(C2W))
+    return np.stack(viewmats)
+
+
+def assert_close(
+    image: np.ndarray,
+    expected: np.ndarray,
+    max_diff: float = 2,
+    max_fraction: float = 1e-3,
+):
+    """
+    Allows max_fraction of values to differ by more than max_diff, e.g. for splats of equal depth blended in either
+    order.
+    """
+    assert image.shape == expected.shape, f"shape {image.shape} != {expected.shape}"
+    assert image.dtype == expected.dtype, f"dtype {image.dtype} != {expected.dtype}"
+    diff = np.abs(image.astype(np.float64) - expected.astype(np.float64))
+    fraction = np.mean(diff > max_diff)
+    assert (
+        fraction <= max_fraction
+    ), f"{fraction:.2%} of values differ by more than {max_diff}, max {diff.max()}"
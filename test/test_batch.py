@@ -0,0 +1,63 @@
+import numpy as np
+import splatstream as ss
+
+from common import assert_close, intrinsics, orbit, random_splat_params
+
+if __name__ == "__main__":
+    width = 128
+    height = 96
+    splats = ss.gaussian_splats(**random_splat_params(1000))
+
+    # (2, 4) views with their own intrinsics, clip planes, backgrounds and SH degrees, drawn as one batch.
+    batch_dims = (2, 4)
+    B = int(np.prod(batch_dims))
+    viewmats = orbit(B).reshape(*batch_dims, 4, 4)
+    Ks = np.stack(
+        [intrinsics(width, height, fov_x) for fov_x in np.linspace(60, 90, B)]
+    )
+    Ks = Ks.reshape(*batch_dims, 3, 3)
+    nears = np.linspace(0.01, 5.0, B).reshape(batch_dims)
+    fars = np.linspace(1e3, 1e5, B).reshape(batch_dims)
+    backgrounds = np.random.rand(*batch_dims, 3)
+    sh_degrees = (np.arange(B) % 4).reshape(batch_dims)
+
+    rendered_image = ss.draw(
+        splats,
+        viewmats,
+        Ks,
+        width,
+        height,
+        near=nears,
+        far=fars,
+        backgrounds=backgrounds,
+        sh_degree=sh_degrees,
+    )
+    assert rendered_image.shape == (*batch_dims, height, width, 4)
+    image = rendered_image.numpy()
+    assert len(rendered_image.compute_timestamps) >= 1
+
+    # Each view matches its own draw.
+    for index in np.ndindex(*batch_dims):
+        expected = ss.draw(
+            splats,
+            viewmats[index],
+            Ks[index],
+            width,
+            height,
+            near=nears[index],
+            far=fars[index],
+            backgrounds=backgrounds[index],
+            sh_degree=int(sh_degrees[index]),
+        ).numpy()
+        assert_close(image[index], expected)
+    print("batch: ok")
+
+    # Front-to-back and the tile rasterizer draw views one at a time within the batch.
+    for kwargs in [dict(front_to_back=True), dict(rasterizer="tile")]:
+        image = ss.draw(splats, viewmats, Ks, width, height, far=1e5, **kwargs).numpy()
+        for index in np.ndindex(*batch_dims):
+            expected = ss.draw(
+                splats, viewmats[index], Ks[index], width, height, far=1e5, **kwargs
+            ).numpy()
+            assert_close(image[index], expected)
+    print("batch options: ok")
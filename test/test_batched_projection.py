@@ -0,0 +1,24 @@
+import numpy as np
+import splatstream as ss
+
+from common import assert_close, intrinsics, orbit, random_splat_params
+
+if __name__ == "__main__":
+    width = 32
+    height = 24
+    K = intrinsics(width, height)
+    splats = ss.gaussian_splats(**random_splat_params(1000))
+
+    # Small views of a batch share one rank, sort and projection per chunk of up to 64 views. More views than a chunk
+    # match views drawn one at a time, up to splats of equal depth in their keys.
+    for radius in [10.0, 1000.0]:
+        viewmats = orbit(100, radius=radius)
+        image = ss.draw(splats, viewmats, K, width, height, far=1e5).numpy()
+        expected = np.stack(
+            [
+                ss.draw(splats, viewmat, K, width, height, far=1e5).numpy()
+                for viewmat in viewmats
+            ]
+        )
+        assert_close(image, expected)
+    print("batched projection: ok")
@@ -0,0 +1,55 @@
+import numpy as np
+import splatstream as ss
+
+from common import assert_close, orbit, random_splat_params
+
+
+def face_viewmats(viewmat: np.ndarray) -> np.ndarray:
+    """
+    (6, 4, 4) view matrices of the cubemap faces of a camera, right, left, up, down, backward and forward. Face
+    rotations are look-at matrices in the Y-up camera space of the engine, so they are conjugated by the Y-down flip.
+    """
+    faces = [
+        ((1, 0, 0), (0, 1, 0)),
+        ((-1, 0, 0), (0, 1, 0)),
+        ((0, 1, 0), (0, 0, 1)),
+        ((0, -1, 0), (0, 0, -1)),
+        ((0, 0, 1), (0, 1, 0)),
+        ((0, 0, -1), (0, 1, 0)),
+    ]
+    flip = np.diag([1.0, -1.0, -1.0, 1.0])
+    viewmats = []
+    for forward, up in faces:
+        forward = np.array(forward, dtype=np.float64)
+        side = np.cross(forward, up)
+        rotation = np.eye(4)
+        rotation[0, :3] = side
+        rotation[1, :3] = np.cross(side, forward)
+        rotation[2, :3] = -forward
+        viewmats.append(flip @ rotation @ flip @ viewmat)
+    return np.stack(viewmats)
+
+
+if __name__ == "__main__":
+    size = 128
+    splats = ss.gaussian_splats(**random_splat_params(1000))
+    viewmat = orbit(1, radius=3.0)[0]
+
+    # Faces share one visibility and sort pass, and match 90 degree views rotated to each face.
+    faces = ss.draw_cubemap(splats, viewmat, size, far=1e5).numpy()
+    assert faces.shape == (6, size, size, 4)
+    K = np.array([[size / 2, 0, size / 2], [0, size / 2, size / 2], [0, 0, 1]])
+    expected = ss.draw(splats, face_viewmats(viewmat), K, size, size, far=1e5).numpy()
+    assert_close(faces, expected, max_fraction=1e-2)
+    print("cubemap: ok")
+
+    # Equirectangular panorama with the forward face at the center, up to resampling.
+    equirect_width = 512
+    panorama = ss.draw_cubemap(
+        splats, viewmat, size, far=1e5, equirect_width=equirect_width
+    ).numpy()
+    assert panorama.shape == (equirect_width // 2, equirect_width, 4)
+    center = panorama[120:136, 248:264].astype(np.float64)
+    forward = faces[5, 56:72, 56:72].astype(np.float64)
+    assert np.abs(center.mean(axis=(0, 1)) - forward.mean(axis=(0, 1))).max() < 16
+    print("equirect: ok")
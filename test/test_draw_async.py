@@ -0,0 +1,35 @@
+import asyncio
+
+import splatstream as ss
+
+from common import assert_close, intrinsics, orbit, random_splat_params
+
+
+async def main(splats, viewmats, K, width, height):
+    # Requests in flight at once, awaited on the loop rather than on executor threads.
+    images = await asyncio.gather(
+        *[
+            ss.draw_async(splats, viewmat, K, width, height, far=1e5)
+            for viewmat in viewmats
+        ]
+    )
+    return [image.numpy() for image in images]
+
+
+if __name__ == "__main__":
+    width = 128
+    height = 96
+    K = intrinsics(width, height)
+    viewmats = orbit(16)
+    splats = ss.gaussian_splats(**random_splat_params(1000))
+
+    images = asyncio.run(main(splats, viewmats, K, width, height))
+    for viewmat, image in zip(viewmats, images):
+        expected = ss.draw(splats, viewmat, K, width, height, far=1e5).numpy()
+        assert_close(image, expected)
+    print("draw_async: ok")
+
+    rendered_image = ss.draw(splats, viewmats, K, width, height, far=1e5)
+    assert asyncio.run(rendered_image.wait_async()) is rendered_image
+    assert rendered_image.ready()
+    print("wait_async: ok")
@@ -0,0 +1,76 @@
+import numpy as np
+import splatstream as ss
+
+from common import assert_close, intrinsics, orbit, random_splat_params
+
+if __name__ == "__main__":
+    splats = ss.gaussian_splats(**random_splat_params(1000))
+
+    width = 256
+    height = 192
+    K = intrinsics(width, height)
+
+    frame_count = 16
+    viewmats = orbit(frame_count)
+    expected = ss.draw(splats, viewmats, K, width, height, far=1e5).numpy()
+
+    # out=: written in place, and returned by numpy().
+    out = np.zeros_like(expected)
+    image = ss.draw(splats, viewmats, K, width, height, far=1e5, out=out).numpy()
+    assert np.shares_memory(image, out)
+    assert_close(out, expected)
+    print("out: ok")
+
+    # out= of another output format.
+    expected_rgb = ss.draw(
+        splats, viewmats, K, width, height, far=1e5, output_format="rgb8"
+    ).numpy()
+    out_rgb = np.zeros((frame_count, height, width, 3), dtype=np.uint8)
+    ss.draw(
+        splats, viewmats, K, width, height, far=1e5, output_format="rgb8", out=out_rgb
+    ).wait()
+    assert_close(out_rgb, expected_rgb)
+    assert_close(out_rgb, expected[..., :3])
+    print("out rgb8: ok")
+
+    # DrawContext: frames rotate through buffer_count buffers, and match plain draws.
+    buffer_count = 3
+    context = ss.DrawContext(
+        viewmats[0], K, width, height, buffer_count=buffer_count, far=1e5
+    )
+    assert context.batch_dims == ()
+    addresses = set()
+    for i in range(frame_count):
+        rendered_image = context.draw(splats, viewmats[i], K)
+        frame = rendered_image.numpy()
+        addresses.add(frame.__array_interface__["data"][0])
+        assert_close(frame, expected[i])
+    assert len(addresses) == buffer_count, f"{len(addresses)} buffers used"
+    print("DrawContext: ok")
+
+    # DrawContext with out=, leaving the buffers of the context untouched.
+    out = np.zeros_like(expected[0])
+    image = context.draw(splats, viewmats[1], K, out=out).numpy()
+    assert np.shares_memory(image, out)
+    assert_close(out, expected[1])
+    assert_close(frame, expected[frame_count - 1])
+    print("DrawContext out: ok")
+
+    # DrawContext of a batch, with cameras set in place.
+    context = ss.DrawContext(viewmats[:4], K, width, height, far=1e5)
+    assert context.batch_dims == (4,)
+    for first in range(0, frame_count, 4):
+        context.set_cameras(viewmats[first : first + 4], K)
+        assert_close(context.draw(splats).numpy(), expected[first : first + 4])
+    print("DrawContext batch: ok")
+
+    # out= read-only, rejected before the draw writes to it.
+    out = np.zeros_like(expected)
+    out.setflags(write=False)
+    try:
+        ss.draw(splats, viewmats, K, width, height, far=1e5, out=out)
+        raise AssertionError("read-only out accepted")
+    except ValueError as e:
+        assert "writeable" in str(e), e
+    assert not out.any()
+    print("out read-only: ok")
@@ -0,0 +1,35 @@
+import numpy as np
+import splatstream as ss
+
+from common import assert_close, intrinsics, orbit, random_splat_params
+
+if __name__ == "__main__":
+    width = 256
+    height = 192
+    K = intrinsics(width, height)
+    viewmats = orbit(8)
+
+    # Near to far blending matches far to near, up to fragments skipped behind saturated pixels and 8-bit rounding.
+    splats = ss.gaussian_splats(**random_splat_params(1000))
+    expected = ss.draw(splats, viewmats, K, width, height, far=1e5).numpy()
+    image = ss.draw(
+        splats, viewmats, K, width, height, far=1e5, front_to_back=True
+    ).numpy()
+    assert_close(image, expected, max_fraction=1e-2)
+    print("front_to_back: ok")
+
+    # Dense opaque splats saturate most pixels, so that fewer fragments are shaded.
+    params = random_splat_params(20000, radius=1.0)
+    params["opacities"] = np.full(20000, 0.99)
+    dense_splats = ss.gaussian_splats(**params)
+    expected = ss.draw(dense_splats, viewmats, K, width, height, far=1e5)
+    rendered_image = ss.draw(
+        dense_splats, viewmats, K, width, height, far=1e5, front_to_back=True
+    )
+    assert_close(rendered_image.numpy(), expected.numpy(), max_fraction=1e-2)
+    # Fragment counts are 0 where pipeline statistics are not supported.
+    if expected.fragment_counts.sum() > 0:
+        assert (
+            rendered_image.fragment_counts.sum() < expected.fragment_counts.sum()
+        ), "no fragments skipped"
+    print("saturation: ok")
@@ -0,0 +1,169 @@
+import os
+import struct
+import tempfile
+import threading
+
+import numpy as np
+import splatstream as ss
+from PIL import Image
+
+from common import intrinsics, orbit, random_splat_params
+
+
+def _read_exr(path: str) -> np.ndarray:
+    # Uncompressed scanline OpenEXR of one pixel type, as written by ImageSink.
+    with open(path, "rb") as f:
+        data = f.read()
+    assert struct.unpack_from("<ii", data, 0) == (20000630, 2)
+
+    attributes = {}
+    offset = 8
+    while data[offset] != 0:
+        name_end = data.index(b"\0", offset)
+        type_end = data.index(b"\0", name_end + 1)
+        (size,) = struct.unpack_from("<i", data, type_end + 1)
+        value_offset = type_end + 5
+        name = data[offset:name_end].decode()
+        attributes[name] = data[value_offset : value_offset + size]
+        offset = value_offset + size
+    offset += 1
+    assert attributes["compression"] == b"\0"
+
+    names = []
+    pixel_types = set()
+    channel_list = attributes["channels"]
+    position = 0
+    while channel_list[position] != 0:
+        name_end = channel_list.index(b"\0", position)
+        names.append(channel_list[position:name_end].decode())
+        pixel_types.add(struct.unpack_from("<i", channel_list, name_end + 1)[0])
+        position = name_end + 17
+    assert names == sorted(names) and len(pixel_types) == 1
+    dtype = np.dtype({1: "<f2", 2: "<f4"}[pixel_types.pop()])
+
+    x_min, y_min, x_max, y_max = struct.unpack("<iiii", attributes["dataWindow"])
+    width = x_max - x_min + 1
+    height = y_max - y_min + 1
+    offsets = np.frombuffer(data, dtype="<u8", count=height, offset=offset)
+
+    image = np.empty((height, width, len(names)), dtype=dtype)
+    for y, block_offset in enumerate(offsets):
+        line_y, size = struct.unpack_from("<ii", data, int(block_offset))
+        assert line_y == y and size == width * len(names) * dtype.itemsize
+        line = np.frombuffer(
+            data, dtype=dtype, count=width * len(names), offset=int(block_offset) + 8
+        )
+        image[y] = line.reshape(len(names), width).T
+
+    # Back to R, G, B, A order.
+    order = ["Y"] if names == ["Y"] else [name for name in "RGBA" if name in names]
+    return image[..., [names.index(name) for name in order]]
+
+
+if __name__ == "__main__":
+    splats = ss.gaussian_splats(**random_splat_params(1000))
+
+    width = 256
+    height = 192
+    K = intrinsics(width, height)
+
+    frame_count = 16
+    viewmats = orbit(frame_count)
+    expected = ss.draw(splats, viewmats, K, width, height, far=1e5).numpy()
+
+    with tempfile.TemporaryDirectory() as directory:
+        # Indices follow submission order, across draws and numpy copies.
+        written = []
+        written_lock = threading.Lock()
+
+        def on_written(index, path):
+            with written_lock:
+                written.append(index)
+
+        with ss.ImageSink(
+            directory,
+            "frame_{index:03d}.png",
+            workers=4,
+            max_pending=3,
+            on_written=on_written,
+        ) as sink:
+            images = ss.draw(splats, viewmats[:8], K, width, height, far=1e5)
+            assert sink.submit(images) == list(range(8))
+            for i in range(8, frame_count):
+                images = ss.draw(splats, viewmats[i], K, width, height, far=1e5)
+                image = images.numpy().copy()
+                assert sink.submit(image) == [i]
+        paths = sink.close()
+
+        assert sorted(written) == list(range(frame_count))
+        assert paths == [
+            os.path.join(directory, f"frame_{i:03d}.png") for i in range(frame_count)
+        ]
+
+        # Files match the images.
+        for i, path in enumerate(paths):
+            assert np.array_equal(np.asarray(Image.open(path)), expected[i])
+        print("png: ok")
+
+        # JPEG of the color channels, lossy.
+        with ss.ImageSink(directory, "{index}.jpg") as sink:
+            sink.submit(expected[:2])
+        for i, path in enumerate(sink.close()):
+            image = np.asarray(Image.open(path)).astype(np.float32)
+            assert image.shape == (height, width, 3)
+            assert np.mean(np.abs(image - expected[i, ..., :3])) < 8
+        print("jpeg: ok")
+
+        # EXR round trip of float images, 1 to 4 channels.
+        for dtype in [np.float16, np.float32]:
+            for channels in [1, 3, 4]:
+                images = np.random.randn(3, height, width, channels).astype(dtype)
+                with ss.ImageSink(directory, f"{{index}}_{channels}.exr") as sink:
+                    sink.submit(images)
+                for i, path in enumerate(sink.close()):
+                    assert np.array_equal(_read_exr(path), images[i])
+        print("exr: ok")
+
+        # EXR of a float draw.
+        images = ss.draw(
+            splats, viewmats[:2], K, width, height, far=1e5, output_format="rgba16f"
+        )
+        with ss.ImageSink(directory, "{index}_draw.exr") as sink:
+            sink.submit(images)
+        for i, path in enumerate(sink.close()):
+            assert np.array_equal(_read_exr(path), images.numpy()[i])
+        print("exr draw: ok")
+
+        # Failures are raised by close.
+        sink = ss.ImageSink(directory, "{index}_error.png")
+        sink.submit(np.zeros((2, height, width, 4), dtype=np.float32))
+        error = None
+        try:
+            sink.close()
+        except AssertionError as e:
+            error = e
+        assert error is not None and "uint8" in str(error), "float PNG written"
+
+        # Planar or non-image layouts are rejected by submit.
+        sink = ss.ImageSink(directory, "{index}_layout.png")
+        for shape in [(2, 4, height, width), (height, width), (height, width, 2)]:
+            try:
+                sink.submit(np.zeros(shape, dtype=np.uint8))
+                raise AssertionError(f"shape {shape} submitted")
+            except ValueError as e:
+                assert "(..., H, W, C)" in str(e), e
+        try:
+            sink.submit(np.zeros((height, width, 4), dtype=np.float64))
+            raise AssertionError("float64 submitted")
+        except ValueError as e:
+            assert "float64" in str(e), e
+        assert sink.close() == []
+        print("error: ok")
+
+        # Single channel images are written as grayscale.
+        images = expected[:2, ..., :1].copy()
+        with ss.ImageSink(directory, "{index}_gray.png") as sink:
+            sink.submit(images)
+        for i, path in enumerate(sink.close()):
+            assert np.array_equal(np.asarray(Image.open(path)), images[i, ..., 0])
+        print("gray: ok")
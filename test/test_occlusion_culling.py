@@ -0,0 +1,54 @@
+import numpy as np
+import splatstream as ss
+
+from common import assert_close, intrinsics, orbit, random_splat_params
+
+if __name__ == "__main__":
+    width = 256
+    height = 192
+    K = intrinsics(width, height)
+    # Nearby views of a batch, each culled against a previous image.
+    viewmats = orbit(128)[:8]
+
+    # Dense opaque splats hide most splats behind them.
+    N = 20000
+    params = random_splat_params(N, radius=1.0)
+    params["opacities"] = np.full(N, 0.99)
+    splats = ss.gaussian_splats(**params)
+
+    expected = ss.draw(
+        splats, viewmats, K, width, height, far=1e5, front_to_back=True
+    ).numpy()
+    rendered_image = ss.draw(
+        splats,
+        viewmats,
+        K,
+        width,
+        height,
+        far=1e5,
+        front_to_back=True,
+        occlusion_culling=True,
+    )
+    # Culled splats are only those hidden behind saturated pixels, up to the motion between views.
+    assert_close(rendered_image.numpy(), expected, max_fraction=1e-2)
+    assert rendered_image.occlusion_culled_counts[1:].min() > 0, "nothing culled"
+    assert rendered_image.occlusion_culled_counts.max() < N
+    print("occlusion culling: ok")
+
+    # Sparse splats hide nothing, and match without culling.
+    splats = ss.gaussian_splats(**random_splat_params(1000))
+    expected = ss.draw(
+        splats, viewmats, K, width, height, far=1e5, front_to_back=True
+    ).numpy()
+    image = ss.draw(
+        splats,
+        viewmats,
+        K,
+        width,
+        height,
+        far=1e5,
+        front_to_back=True,
+        occlusion_culling=True,
+    ).numpy()
+    assert_close(image, expected, max_fraction=1e-2)
+    print("sparse: ok")
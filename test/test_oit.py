@@ -0,0 +1,26 @@
+import numpy as np
+import splatstream as ss
+
+from common import assert_close, intrinsics, orbit, random_splat_params
+
+if __name__ == "__main__":
+    width = 256
+    height = 192
+    K = intrinsics(width, height)
+    viewmats = orbit(8)
+    splats = ss.gaussian_splats(**random_splat_params(1000))
+
+    expected = ss.draw(splats, viewmats, K, width, height, far=1e5).numpy()
+    image = ss.draw(
+        splats, viewmats, K, width, height, far=1e5, rasterizer="oit"
+    ).numpy()
+
+    # Coverage does not depend on blend order, up to float16 accumulation.
+    assert_close(image[..., 3], expected[..., 3], max_fraction=1e-2)
+    print("oit alpha: ok")
+
+    # Colors are a weighted average instead of ordered blending, close enough for previews.
+    mse = np.mean((image[..., :3] / 255.0 - expected[..., :3] / 255.0) ** 2)
+    psnr = -10 * np.log10(max(mse, 1e-10))
+    assert psnr > 20, f"PSNR {psnr:.2f}"
+    print(f"oit color: ok, PSNR {psnr:.2f}")
@@ -0,0 +1,64 @@
+import numpy as np
+import splatstream as ss
+
+from common import assert_close, intrinsics, orbit, random_splat_params
+
+if __name__ == "__main__":
+    splats = ss.gaussian_splats(**random_splat_params(1000))
+
+    width = 256
+    height = 192
+    K = intrinsics(width, height)
+
+    frame_count = 24
+    viewmats = orbit(frame_count)
+    expected = ss.draw(splats, viewmats, K, width, height, far=1e5).numpy()
+
+    # Frames are yielded in camera order, each valid until the next one is yielded.
+    for in_flight in [None, 1, 2, 4, 8, 32]:
+        cameras = ((viewmats[i], K) for i in range(frame_count))
+        count = 0
+        for i, frame in enumerate(
+            ss.render_stream(
+                splats, cameras, width, height, in_flight=in_flight, far=1e5
+            )
+        ):
+            assert_close(frame.numpy(), expected[i])
+            count += 1
+        assert count == frame_count, f"{count} frames of {frame_count}"
+        print(f"in_flight {in_flight}: ok")
+
+    # depth is passed to draw, as for ss.draw.
+    expected_depth = ss.draw(
+        splats, viewmats, K, width, height, far=1e5, depth=True
+    ).depth()
+    cameras = ((viewmats[i], K) for i in range(frame_count))
+    for i, frame in enumerate(
+        ss.render_stream(splats, cameras, width, height, far=1e5, depth=True)
+    ):
+        assert np.allclose(frame.depth(), expected_depth[i], rtol=1e-4, atol=1e-4)
+    print("depth outputs: ok")
+
+    # Frames of stereo-like batches, (2, H, W, 4) each.
+    cameras = ((viewmats[i : i + 2], K) for i in range(0, frame_count, 2))
+    for i, frame in enumerate(
+        ss.render_stream(splats, cameras, width, height, far=1e5)
+    ):
+        assert frame.shape == (2, height, width, 4)
+        assert_close(frame.numpy(), expected[2 * i : 2 * i + 2])
+    assert i == frame_count // 2 - 1
+    print("batch: ok")
+
+    # Frames kept past the next yield must be copied.
+    frames = [
+        frame.numpy().copy()
+        for frame in ss.render_stream(
+            splats, zip(viewmats, [K] * frame_count), width, height, far=1e5
+        )
+    ]
+    assert_close(np.stack(frames), expected)
+    print("copies: ok")
+
+    # No cameras, no frames.
+    assert list(ss.render_stream(splats, [], width, height)) == []
+    print("empty: ok")
@@ -0,0 +1,46 @@
+import numpy as np
+import splatstream as ss
+
+from common import assert_close, intrinsics, orbit, random_splat_params
+
+if __name__ == "__main__":
+    width = 256
+    height = 192
+    K = intrinsics(width, height)
+    viewmats = orbit(4)
+    splats = ss.gaussian_splats(**random_splat_params(1000))
+    expected = ss.draw(splats, viewmats, K, width, height, far=1e5).numpy()
+
+    # Regions match crops of whole images, with a region per view, including ones at the image borders.
+    w, h = 96, 64
+    rois = np.array(
+        [[0, 0, w, h], [40, 30, w, h], [width - w, height - h, w, h], [17, 101, w, h]]
+    )
+    rendered_image = ss.draw(splats, viewmats, K, width, height, far=1e5, roi=rois)
+    assert rendered_image.shape == (4, h, w, 4)
+    image = rendered_image.numpy()
+    for i, (x, y, _, _) in enumerate(rois):
+        assert_close(image[i], expected[i, y : y + h, x : x + w])
+    print("roi: ok")
+
+    # Depth outputs of the region.
+    expected = ss.draw(splats, viewmats[0], K, width, height, far=1e5, depth=True)
+    rendered_image = ss.draw(
+        splats, viewmats[0], K, width, height, far=1e5, depth=True, roi=rois[1]
+    )
+    x, y = rois[1][:2]
+    assert_close(
+        rendered_image.alpha(), expected.alpha()[y : y + h, x : x + w], max_diff=1e-2
+    )
+    print("roi depth: ok")
+
+    # Regions of a batch have one size.
+    error = None
+    try:
+        ss.draw(
+            splats, viewmats[:2], K, width, height, roi=[[0, 0, w, h], [0, 0, h, w]]
+        )
+    except AssertionError as e:
+        error = e
+    assert error is not None, "regions of different sizes drawn"
+    print("roi size: ok")
@@ -0,0 +1,42 @@
+import numpy as np
+import splatstream as ss
+
+from common import assert_close, intrinsics, orbit, random_splat_params
+
+
+def stereo_pairs(viewmats: np.ndarray, baseline: float) -> np.ndarray:
+    """(N, 2, 4, 4) (left, right) eyes offset along the camera x axis of (N, 4, 4) view matrices."""
+    pairs = np.repeat(viewmats[:, None], 2, axis=1)
+    pairs[:, 0, 0, 3] += baseline / 2
+    pairs[:, 1, 0, 3] -= baseline / 2
+    return pairs
+
+
+if __name__ == "__main__":
+    width = 256
+    height = 192
+    K = intrinsics(width, height)
+    splats = ss.gaussian_splats(**random_splat_params(1000))
+    viewmats = stereo_pairs(orbit(4), 0.064)
+
+    # One shared visibility and sort per pair, keyed by depth from the midpoint of the eyes. Splats close in depth may
+    # blend in another order than in independent draws.
+    expected = ss.draw(splats, viewmats, K, width, height, far=1e5).numpy()
+    rendered_image = ss.draw(splats, viewmats, K, width, height, far=1e5, stereo=True)
+    assert rendered_image.shape == (4, 2, height, width, 4)
+    assert_close(rendered_image.numpy(), expected, max_fraction=2e-2)
+    print("stereo: ok")
+
+    # Eyes see different images.
+    image = rendered_image.numpy()
+    assert not np.array_equal(image[:, 0], image[:, 1])
+    print("stereo eyes: ok")
+
+    # The last batch dim must be a pair.
+    error = None
+    try:
+        ss.draw(splats, viewmats[:, :1], K, width, height, stereo=True)
+    except AssertionError as e:
+        error = e
+    assert error is not None and "eye pairs" in str(error), "unpaired eyes drawn"
+    print("stereo pairs: ok")
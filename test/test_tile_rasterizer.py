@@ -0,0 +1,52 @@
+import numpy as np
+import splatstream as ss
+
+from common import assert_close, intrinsics, orbit, random_splat_params
+
+if __name__ == "__main__":
+    width = 256
+    height = 192
+    K = intrinsics(width, height)
+    viewmats = orbit(8)
+
+    # Splats covering most of the 16 x 12 tiles request more pairs than the initial capacity of 8 per point. The draw
+    # raises instead of dropping them silently, and the capacity grows for the next draw.
+    N = 16
+    params = random_splat_params(N, radius=0.5)
+    params["scales"] = np.full((N, 3), 3.0)
+    params["opacities"] = np.full(N, 0.5)
+    large_splats = ss.gaussian_splats(**params)
+    try:
+        ss.draw(
+            large_splats, viewmats[0], K, width, height, far=1e5, rasterizer="tile"
+        ).numpy()
+        raise AssertionError("pairs over capacity not reported")
+    except RuntimeError as e:
+        assert "dropped" in str(e), e
+    image = ss.draw(
+        large_splats, viewmats[0], K, width, height, far=1e5, rasterizer="tile"
+    ).numpy()
+    expected = ss.draw(large_splats, viewmats[0], K, width, height, far=1e5).numpy()
+    assert_close(image, expected, max_fraction=1e-2)
+    print("capacity: ok")
+
+    # Matches the hardware rasterizer, up to early termination and float16 blending.
+    splats = ss.gaussian_splats(**random_splat_params(1000))
+    expected = ss.draw(splats, viewmats, K, width, height, far=1e5).numpy()
+    image = ss.draw(
+        splats, viewmats, K, width, height, far=1e5, rasterizer="tile"
+    ).numpy()
+    assert_close(image, expected, max_fraction=1e-2)
+    print("tile: ok")
+
+    # Depth outputs, with the median depth only computed by the tile rasterizer.
+    expected = ss.draw(splats, viewmats, K, width, height, far=1e5, depth=True)
+    rendered_image = ss.draw(
+        splats, viewmats, K, width, height, far=1e5, rasterizer="tile", depth=True
+    )
+    assert_close(rendered_image.alpha(), expected.alpha(), max_diff=1e-2)
+    # Transmittance falls below 0.5 at a splat in front of the camera where alpha is above 0.5.
+    median_depth = rendered_image.median_depth()
+    assert np.all(median_depth[rendered_image.alpha() > 0.51] > 0)
+    assert np.all(median_depth[rendered_image.alpha() < 0.49] == 0)
+    print("tile depth: ok")
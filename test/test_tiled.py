@@ -0,0 +1,36 @@
+import splatstream as ss
+
+from common import assert_close, intrinsics, orbit, random_splat_params
+
+if __name__ == "__main__":
+    width = 256
+    height = 192
+    K = intrinsics(width, height)
+    viewmats = orbit(4)
+    splats = ss.gaussian_splats(**random_splat_params(1000))
+    expected = ss.draw(splats, viewmats, K, width, height, far=1e5).numpy()
+
+    # Images drawn tile by tile match whole images, including partial tiles at the right and bottom edges.
+    for tile_size in [64, 80]:
+        image = ss.draw(
+            splats, viewmats, K, width, height, far=1e5, tile_size=tile_size
+        ).numpy()
+        assert_close(image, expected)
+    print("tiled: ok")
+
+    # Float outputs are tiled alike.
+    expected = ss.draw(
+        splats, viewmats, K, width, height, far=1e5, output_format="rgb32f"
+    ).numpy()
+    image = ss.draw(
+        splats,
+        viewmats,
+        K,
+        width,
+        height,
+        far=1e5,
+        output_format="rgb32f",
+        tile_size=64,
+    ).numpy()
+    assert_close(image, expected, max_diff=1e-2)
+    print("tiled float: ok")